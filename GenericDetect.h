@@ -26,6 +26,34 @@
  * A simple header only library for detecting stuff like the target operating
  * system, the compiler, etc.
  *
+ * This header only includes the sub-headers in the GenericDetect directory.
+ * Source files that only need a part of the library can include the matching
+ * sub-header instead, which pulls in just the parts it depends on:
+ *  - GenericDetect/Base.h     - the library options, versioning, gd_u64_t and gd_i64_t
+ *  - GenericDetect/Compiler.h - GD_COMPILER_*
+ *  - GenericDetect/OS.h       - GD_OS_*
+ *  - GenericDetect/Arch.h     - GD_ARCH_* and GD_BITS
+ *  - GenericDetect/Build.h    - GD_BUILD_*, GD_FAST_MATH and GD_SANITIZER_*
+ *  - GenericDetect/SIMD.h     - GD_SIMD_*
+ *  - GenericDetect/Endian.h   - GD_ENDIAN_* and the byte order helpers
+ *  - GenericDetect/Memory.h   - GD_CACHE_LINE_SIZE and GD_PAGE_SIZE_DEFAULT
+ *  - GenericDetect/ABI.h      - GD_DATA_MODEL_*, GD_SIZEOF_*, GD_MAX_ALIGN and GD_ABI_*
+ *  - GenericDetect/LibC.h     - GD_LIBC_* (the only one including libc headers)
+ *  - GenericDetect/Language.h - GD_C_STANDARD, GD_CXX_STANDARD, OpenMP, parallel
+ *                               algorithms, coroutines, std::simd and threads
+ *  - GenericDetect/Hints.h    - function attributes and optimization hints
+ *  - GenericDetect/Bits.h     - bit manipulation
+ *  - GenericDetect/Atomics.h  - atomic and lock-free capabilities
+ *  - GenericDetect/Sync.h     - futex, WaitOnAddress, membarrier, rseq and friends
+ *  - GenericDetect/Runtime.h  - the runtime detection functions
+ * The implementation of the runtime functions is in GenericDetect/Implementation.h,
+ * which this header includes when GD_IMPLEMENTATION is defined.
+ *
+ * For C++11 and newer, GenericDetect.hpp next to this header provides the same
+ * information as constexpr values and trait types in the gd namespace (gd::os,
+ * gd::arch, gd::compiler_version >= gd::version(12, 0, 0), ...), see its top
+ * comment for the list.
+ *
  * Note on versioning:
  * Every version is normalized into the same format which is: 0xAABBCCCC
  * (AA - major, BB - minor, CCCC - patch). For creating versions there is
@@ -134,8 +162,338 @@
  * 
  * For detecting the bit count of a architecture you can use the GD_BITS macro.
  * 
- * For the glibc C library there is the GD_LIBC_GLIBC macro defined. There are
- * also the GD_LIBC_NAME and GC_LIBC_VERSION macros.
+ * Build configuration (all 1 or 0, and all can be overridden by the build system):
+ *  - GD_BUILD_OPTIMIZED, GD_BUILD_OPTIMIZED_SIZE - built with optimizations
+ *    (-O1 and up, or -Os)
+ *  - GD_BUILD_DEBUG - assertions are enabled (no NDEBUG) or the debug runtime
+ *    is used (_DEBUG)
+ *  - GD_BUILD_LTO - link time optimization, compilers do not report it, so it
+ *    is only 1 when defined by the build system
+ *  - GD_BUILD_PGO_GENERATE, GD_BUILD_PGO_USE - instrumented for profile guided
+ *    optimization or optimized with a profile (Clang only)
+ *  - GD_FAST_MATH - -ffast-math or /fp:fast
+ *  - GD_SANITIZER_ADDRESS, GD_SANITIZER_THREAD, GD_SANITIZER_MEMORY,
+ *    GD_SANITIZER_UNDEFINED - built with that sanitizer
+ * 
+ * To detect the SIMD extensions the code is being compiled for check if any of
+ * the macros listed below are defined or use the GD_IS_SIMD(simd) macro. Every
+ * extension also defines all the extensions it implies, e.g. GD_SIMD_AVX2 implies
+ * GD_SIMD_AVX, GD_SIMD_SSE4_2 and so on, no matter what the compiler defines.
+ * 
+ * Supported SIMD extensions:
+ *  - x86:       GD_SIMD_SSE, GD_SIMD_SSE2, GD_SIMD_SSE3, GD_SIMD_SSSE3,
+ *               GD_SIMD_SSE4_1, GD_SIMD_SSE4_2, GD_SIMD_AVX, GD_SIMD_AVX2,
+ *               GD_SIMD_FMA, GD_SIMD_AVX512F, GD_SIMD_AVX512CD, GD_SIMD_AVX512BW,
+ *               GD_SIMD_AVX512DQ, GD_SIMD_AVX512VL, GD_SIMD_AVX512IFMA,
+ *               GD_SIMD_AVX512VBMI, GD_SIMD_AVX512VBMI2, GD_SIMD_AVX512VNNI,
+ *               GD_SIMD_AVX512BITALG, GD_SIMD_AVX512VPOPCNTDQ, GD_SIMD_AVX512BF16,
+ *               GD_SIMD_AVX512FP16, GD_SIMD_AVX10 (with GD_SIMD_AVX10_VERSION)
+ *  - x86 scalar: GD_SIMD_POPCNT, GD_SIMD_LZCNT, GD_SIMD_BMI1, GD_SIMD_BMI2,
+ *                GD_SIMD_F16C, GD_SIMD_MOVBE
+ *  - ARM:       GD_SIMD_NEON, GD_SIMD_SVE, GD_SIMD_SVE2 (with GD_SIMD_SVE_BITS)
+ *  - RISC-V:    GD_SIMD_RVV (with GD_SIMD_RVV_BITS and GD_SIMD_RVV_MIN_BITS)
+ *  - PowerPC:   GD_SIMD_ALTIVEC, GD_SIMD_VSX
+ *  - LoongArch: GD_SIMD_LSX, GD_SIMD_LASX
+ * 
+ * GD_SIMD_SVE_BITS and GD_SIMD_RVV_BITS are 0 when the vector length is only
+ * known at runtime.
+ * 
+ * The GD_SIMD_NAME macro is defined with the name of the widest available
+ * extension ("None" if there is none) and GD_SIMD_MAX_WIDTH_BITS with the
+ * width of its registers in bits (0 if there is no SIMD). For length agnostic
+ * extensions the guaranteed minimum width is used.
+ * 
+ * The byte order of the target is reported by GD_ENDIAN_LITTLE, GD_ENDIAN_BIG or
+ * GD_ENDIAN_PDP (also GD_IS_ENDIAN(endian) and GD_ENDIAN_NAME). GD_UNALIGNED_ACCESS_FAST
+ * is 1 if unaligned loads and stores are handled by the hardware at full speed.
+ * 
+ * GD_BSWAP16, GD_BSWAP32 and GD_BSWAP64 (and the gd_bswap16/32/64 functions) map
+ * to the compiler byte swap intrinsics when there are any. For reading and
+ * writing unaligned little and big endian values there are gd_load_le16/32/64,
+ * gd_load_be16/32/64, gd_store_le16/32/64 and gd_store_be16/32/64, which compile
+ * to plain loads and stores (plus a byte swap for the other byte order) wherever
+ * the compiler can express them with memcpy.
+ * 
+ * Optimization hints:
+ * These map to the attributes and builtins of the detected compiler (checked
+ * against GD_COMPILER_VERSION) and expand to nothing where they are unsupported.
+ *  - GD_LIKELY(x), GD_UNLIKELY(x) - branch prediction hints
+ *  - GD_FORCE_INLINE - used instead of GD_INLINE to always inline a function
+ *  - GD_NOINLINE, GD_FLATTEN, GD_HOT, GD_COLD - function attributes
+ *  - GD_RESTRICT - restrict qualifier, also in C++ and C89
+ *  - GD_ASSUME(condition) - lets the optimizer assume the condition holds, it
+ *    must not have side effects
+ *  - GD_UNREACHABLE() - marks code that can never be reached
+ *  - GD_PREFETCH(address, rw, locality) - rw is 0 for reading and 1 for writing,
+ *    locality goes from 0 (no reuse) to 3 (keep in all cache levels)
+ *  - GD_ASSUME_ALIGNED(pointer, alignment) - returns the pointer, which can then
+ *    be assumed to be aligned
+ *  - GD_HAS_ATTRIBUTE(attribute) - __has_attribute, 0 if the compiler lacks it
+ *  - GD_HAS_BUILTIN(builtin) - __has_builtin, 0 if the compiler lacks it
+ * 
+ * Bit manipulation:
+ * gd_popcount32/64, gd_clz32/64, gd_ctz32/64 (returning the bit width for 0),
+ * gd_rotl32/64, gd_rotr32/64, gd_pdep64 and gd_pext64 use the compiler builtins
+ * or intrinsics when the target has an instruction for them and a portable
+ * fallback otherwise. GD_HAS_FAST_POPCOUNT, GD_HAS_FAST_CLZ, GD_HAS_FAST_CTZ and
+ * GD_HAS_FAST_PDEP are 1 when the operation is a single instruction, so code can
+ * choose a different algorithm when it is not (pdep and pext are very slow loops
+ * without BMI2). gd_add_overflow_u32/u64/i32/i64, gd_sub_overflow_u64 and
+ * gd_mul_overflow_u32/u64 store the wrapped result and return 1 on overflow.
+ * 
+ * Atomics:
+ * GD_HAS_C11_ATOMICS is 1 when <stdatomic.h> can be used and GD_HAS_STD_ATOMIC
+ * when <atomic> can. GD_ATOMIC_LOCK_FREE_8/16/32/64/128 are 1 if the target can
+ * do a compare and swap of that width inline, GD_HAS_DWCAS if it can do one of
+ * two pointers at once (needed for tagged pointers, e.g. -mcx16 on x86_64) and
+ * GD_HAS_LSE if the ARMv8.1 atomic instructions can be used. GD_MEMORY_MODEL_TSO
+ * is 1 on strongly ordered architectures like x86 and 0 on weakly ordered ones
+ * like ARM and PowerPC. Note that GCC still routes 16 byte C11 and std::atomic
+ * operations through libatomic, which picks cmpxchg16b or a lock at runtime.
+ *
+ * Synchronization primitives:
+ * GD_HAS_FUTEX (Linux, OpenBSD), GD_HAS_FUTEX_WAITV and GD_HAS_FUTEX2 (Linux),
+ * GD_HAS_UMTX (FreeBSD), GD_HAS_WAIT_ON_ADDRESS (Windows 8+), GD_HAS_ULOCK and
+ * GD_HAS_OS_SYNC_WAIT_ON_ADDRESS (Apple, by deployment target) tell which way
+ * of waiting on an address the target has. GD_HAS_MEMBARRIER is 1 when there is
+ * a process wide barrier for asymmetric fences (membarrier, or
+ * FlushProcessWriteBuffers on Windows), GD_HAS_RSEQ for restartable sequences,
+ * GD_HAS_LIBC_RSEQ when the C library registers them itself (glibc 2.35+) and
+ * GD_HAS_GETCPU when the current CPU can be queried. The kernel can still lack
+ * or block them, which gd_sync_info() checks at runtime (see below).
+ * 
+ * GD_CACHE_LINE_SIZE is the typical cache line size of the target, e.g. 128 on
+ * Apple AArch64 and PowerPC64, 64 on most others. For padding data to avoid
+ * false sharing use GD_DESTRUCTIVE_INTERFERENCE_SIZE (which also covers the
+ * adjacent line prefetchers of x86_64 and AArch64) and for keeping data that is
+ * used together on the same line use GD_CONSTRUCTIVE_INTERFERENCE_SIZE. All
+ * three can be overridden by defining them before including this header.
+ * 
+ * GD_PAGE_SIZE_DEFAULT is the usual page size of the target OS and architecture,
+ * e.g. 16K on Apple AArch64 and 4K on x86. Some kernels use other sizes (16K or
+ * 64K on AArch64 Linux), so use gd_page_size() wherever the real size matters.
+ * 
+ * Data model and ABI:
+ * GD_SIZEOF_POINTER, GD_SIZEOF_LONG and GD_SIZEOF_LONG_DOUBLE are the sizes of
+ * these types (-1 for the pointer if unknown), usable in #if. The data model is
+ * one of GD_DATA_MODEL_LP64, GD_DATA_MODEL_LLP64 (64-bit Windows) or
+ * GD_DATA_MODEL_ILP32, with GD_DATA_MODEL_ILP32_X32 also defined for the x32
+ * ABI of x86_64, and GD_DATA_MODEL_NAME. GD_MAX_ALIGN is the alignment of
+ * max_align_t, the most malloc guarantees.
+ * The calling convention is one of GD_ABI_SYSV (x86 and x86_64), GD_ABI_WIN64,
+ * GD_ABI_WIN32, GD_ABI_AAPCS64 (with GD_ABI_AAPCS64_SVE when SVE types are
+ * passed in the SVE registers) or GD_ABI_AAPCS (with GD_ABI_AAPCS_VFP for the
+ * hard float variant), with GD_ABI_NAME. GD_HAS_VECTORCALL is 1 when __vectorcall
+ * is available and GD_VECTOR_CALL marks a function to use the vector calling
+ * convention of the target (__vectorcall or aarch64_vector_pcs). GD_HAS_VECTOR_PCS
+ * is 1 when the target has either, and 0 when GD_VECTOR_CALL expands to nothing.
+ * 
+ * The C library is detected as one of GD_LIBC_GLIBC, GD_LIBC_MUSL, GD_LIBC_BIONIC,
+ * GD_LIBC_UCLIBC, GD_LIBC_NEWLIB, GD_LIBC_UCRT, GD_LIBC_MSVCRT, GD_LIBC_APPLE or
+ * GD_LIBC_BSD (the libc of FreeBSD, NetBSD, OpenBSD and DragonFly). There are
+ * also the GD_LIBC_NAME and GD_LIBC_VERSION macros, the version is 1.0.0 for
+ * libcs which do not report one (musl, UCRT and Apple) and the API level for
+ * Bionic.
+ *
+ * Language and parallel runtimes:
+ * GD_C_STANDARD and GD_CXX_STANDARD are the year of the language standard being
+ * compiled for (1989, 1999, 2011, ... and 1998, 2011, 2014, ...), drafts count
+ * as the standard they lead to and the other language is 0. GD_CXX_STANDARD uses
+ * _MSVC_LANG with MSVC, so it does not need /Zc:__cplusplus. GD_OPENMP_VERSION
+ * is the OpenMP version enabled with -fopenmp or /openmp, 0 without it.
+ * The C++ library features are read from <version>, which is included in C++
+ * unless GD_NO_LIBC_DETECTION is set:
+ *  - GD_HAS_PSTL - the C++17 parallel algorithms can be used, the backend
+ *    running them is one of GD_PSTL_BACKEND_TBB, GD_PSTL_BACKEND_OPENMP,
+ *    GD_PSTL_BACKEND_THREADS or GD_PSTL_BACKEND_SERIAL (GD_PSTL_BACKEND_NAME).
+ *    libstdc++ uses TBB when its headers are found and otherwise runs them serially
+ *  - GD_HAS_COROUTINES - C++20 coroutines (the language and <coroutine>)
+ *  - GD_HAS_STD_SIMD - std::simd, or std::experimental::simd when
+ *    GD_STD_SIMD_EXPERIMENTAL is 1
+ *  - GD_HAS_THREADS - std::thread in C++, <threads.h> in C
+ * 
+ * Runtime detection:
+ * The macros above describe the target the code is being compiled for. What
+ * the machine running it supports can be queried with the runtime functions,
+ * which are compiled in the source file that defines GD_IMPLEMENTATION.
+ * 
+ * gd_cpu_features() returns a bitset of the GD_CPU_FEATURE_* flags for the
+ * detected architecture, e.g. GD_CPU_FEATURE_AVX2 on x86 or GD_CPU_FEATURE_SVE
+ * on ARM. The CPU is probed once (cpuid and xgetbv on x86, getauxval on Linux,
+ * riscv_hwprobe on RISC-V, sysctl on Apple) and after that the call is a single
+ * load. Only what the CPU and the OS report is included, the compile time
+ * baseline is used only where there is nothing to probe. gd_cpu_has(features)
+ * checks if all of the passed features are present,
+ * gd_cpu_features_baseline() returns the features implied by the GD_SIMD_*
+ * macros and gd_cpu_feature_name(feature) returns the name of a feature.
+ * gd_cpu_has_dwcas() checks the running CPU for a lock free double width compare
+ * and swap (cmpxchg16b on x86_64), for LSE use gd_cpu_has(GD_CPU_FEATURE_LSE).
+ *
+ * CPU model:
+ * Feature bits do not tell how fast the features are, e.g. 512 bit vectors
+ * lower the clock of Skylake-X but not of Zen 4. gd_cpu_model() returns the
+ * vendor (GD_CPU_VENDOR_*), the family, model and stepping from cpuid on x86 or
+ * the fields of MIDR_EL1 on ARM, the brand string and a normalized
+ * microarchitecture (GD_UARCH_HASWELL ... GD_UARCH_GRANITE_RAPIDS, GD_UARCH_ZEN
+ * ... GD_UARCH_ZEN5, GD_UARCH_NEOVERSE_N1, GD_UARCH_APPLE_M1, ...) to select
+ * tuned code and block sizes by. On big.LITTLE systems it describes a big core.
+ * MIDR_EL1 is read from sysfs on Linux, on Apple the chip is taken from the
+ * brand string. gd_cpu_vendor_name(vendor) and gd_uarch_name(uarch) return the
+ * names.
+ *
+ * Function dispatch:
+ * To pick the best implementation of a function for the running CPU once,
+ * declare it with GD_DISPATCH_DECLARE(ret, name, params) and define it with
+ * GD_DISPATCH(ret, name, params, args, resolver) (GD_DISPATCH_VOID(name, params,
+ * args, resolver) for void functions). The resolver takes no arguments and
+ * returns a GD_DISPATCH_TYPE(name) function pointer, e.g.:
+ * 
+ *   GD_DISPATCH_DECLARE(int, sum, (const int* data, int count));
+ * 
+ *   static GD_DISPATCH_TYPE(sum) sum_resolve(void)
+ *   {
+ *       return gd_cpu_has(GD_CPU_FEATURE_AVX2) ? sum_avx2 : sum_generic;
+ *   }
+ * 
+ *   GD_DISPATCH(int, sum, (const int* data, int count), (data, count), sum_resolve);
+ * 
+ * By default sum is a small function which resolves on the first call and then
+ * calls the result through a function pointer. Setting GD_DISPATCH_IFUNC to 1
+ * makes it a GNU indirect function resolved by the dynamic loader when
+ * GD_HAS_IFUNC is 1 (GCC or Clang with glibc on ELF), so calling it costs the
+ * same as any other call through the PLT. The loader runs such resolvers while
+ * it is still relocating the binary, where calls into other functions can crash
+ * (e.g. with -z now or -static-pie). Only use it when every resolver is
+ * self-contained, e.g. uses __builtin_cpu_supports after __builtin_cpu_init on
+ * x86 or the hwcap argument on AArch64, gd_cpu_has is not safe there. Either way
+ * sum is called like a normal function.
+ *
+ * Caches:
+ * gd_cache_info() returns the cache hierarchy of the CPU: the line size and, for
+ * every cache, its level, type, size, line size, associativity and the number of
+ * logical CPUs sharing it. It is read from cpuid leaf 4 / 0x8000001D on x86,
+ * sysfs on Linux, sysctl on Apple and the BSDs and GetLogicalProcessorInformation
+ * on Windows. gd_cache_size(level) returns the size of the data cache at a level.
+ *
+ * Topology:
+ * gd_topology() describes the shape of the machine: the number of logical CPUs,
+ * physical cores, packages and NUMA nodes, the SMT width and, on hybrid CPUs,
+ * the number of performance and efficiency cores. For every online CPU it holds
+ * its package, core, SMT sibling index, NUMA node and core type, and for every
+ * NUMA node its CPU mask (test it with GD_CPU_MASK_HAS), memory and distances to
+ * the other nodes. It is read from sysfs on Linux and from
+ * GetLogicalProcessorInformationEx on Windows, elsewhere only the counts reported
+ * by sysctl or sysconf are known. The CPU and node limits can be changed with
+ * GD_TOPOLOGY_MAX_CPUS and GD_TOPOLOGY_MAX_NODES.
+ * 
+ * gd_thread_pin_cpu(cpu) and gd_thread_pin_node(node) pin the calling thread to
+ * a logical CPU or to the CPUs of a NUMA node (Linux, FreeBSD and Windows), so
+ * memory it touches first is allocated on that node.
+ *
+ * Pages:
+ * gd_page_info() returns the base page size, the allocation granularity of new
+ * mappings, the transparent huge page mode (always, madvise or never) and size,
+ * and every supported huge page size with the number of reserved and free
+ * hugetlbfs pages. It is read from sysconf and sysfs on Linux, getpagesizes on
+ * FreeBSD and GetSystemInfo / GetLargePageMinimum on Windows. The free counts
+ * change over time, gd_page_info_probe(info) reads them again. gd_page_size()
+ * returns just the base page size.
+ *
+ * Resource limits:
+ * gd_limits() reports what the process may actually use, which in a container
+ * is often far less than the machine has: the CPUs in its affinity mask and
+ * cpuset, the CPU quota (cpu_quota / cpu_period CPUs), the physical memory and
+ * the hard (memory_max) and throttling (memory_high) memory limits. On Linux
+ * the limits are read from cgroup v2 (cpu.max, memory.max, memory.high,
+ * cpuset.cpus.effective) or v1 (cpu.cfs_quota_us, memory.limit_in_bytes,
+ * cpuset.effective_cpus), including the ones set on parent cgroups, and on
+ * Windows from the job object of the process. gd_parallelism() returns the
+ * number of threads that can run at once without being throttled, e.g. 4 for a
+ * 4 CPU quota on a 192 CPU host, and gd_memory_budget() the lowest memory limit.
+ * Use them instead of gd_topology() to size thread pools and caches. Limits can
+ * change while the process runs, gd_limits_probe(limits) reads them again.
+ *
+ * Virtualization:
+ * gd_virt_info() tells bare metal apart from a VM and names the hypervisor
+ * (GD_HYPERVISOR_KVM, GD_HYPERVISOR_XEN, GD_HYPERVISOR_HYPERV, ...), along with
+ * GD_VIRT_* flags for what changes the cost of spinning and timing: whether the
+ * OS is the host of the hypervisor, the guest can run nested VMs, the process
+ * runs in a sandbox (gVisor, WSL1), container, WSL or microVM (Firecracker), a
+ * paravirtual clock is there, the TSC can be trusted and the vCPUs are pinned to
+ * physical CPUs. It uses the cpuid hypervisor bit and leaves on x86, and on
+ * Linux /sys/hypervisor, the device tree, the DMI strings and the clock source
+ * the kernel picked, kern.vm_guest on FreeBSD and kern.hv_vmm_present on Apple.
+ * gd_hypervisor_name(hypervisor) returns the name of a hypervisor.
+ *
+ * Timer:
+ * gd_cycles() reads the cheapest timestamp counter of the CPU: rdtsc on x86,
+ * cntvct_el0 on AArch64, rdtime on RISC-V, the time base on PowerPC and the
+ * stable counter on LoongArch. gd_cycles_serialized() does the same, but waits
+ * for all earlier instructions to finish and keeps later ones from starting
+ * before the read, which makes it slower but better suited for timing short
+ * pieces of code. GD_HAS_CYCLE_COUNTER is 0 when there is no counter, then both
+ * return the monotonic clock in nanoseconds. gd_cycles_invariant() checks if
+ * the counter runs at a constant rate (invariant TSC on x86, always the case
+ * elsewhere), gd_cycles_frequency() returns its rate in Hz (read from the CPU or
+ * calibrated once) and gd_cycles_to_ns(cycles) converts a difference of two
+ * readings to nanoseconds.
+ *
+ * Allocator:
+ * gd_allocator() identifies the allocator behind malloc: the default of the C
+ * library (GD_ALLOCATOR_GLIBC, GD_ALLOCATOR_MUSL, ...) or a replacement that is
+ * linked in or preloaded (GD_ALLOCATOR_JEMALLOC, GD_ALLOCATOR_TCMALLOC or
+ * GD_ALLOCATOR_MIMALLOC). jemalloc is recognized by a malloc showing up in its
+ * statistics, so a jemalloc built with --disable-stats is reported as the
+ * default. gd_allocator_name(allocator) returns its name.
+ *
+ * Kernel I/O:
+ * gd_io_info() reports which I/O interfaces the kernel lets the process use, as
+ * GD_IO_* flags (check them with gd_io_has(capabilities)): io_uring, splice,
+ * copy_file_range, sendfile, MSG_ZEROCOPY, memfd_create and userfaultfd on Linux
+ * and kqueue, sendfile, copy_file_range and memfd_create on the BSDs and Apple.
+ * The Linux interfaces are tried, so ones disabled by sysctl or seccomp are not
+ * reported. On FreeBSD copy_file_range and memfd_create follow the version of the
+ * running kernel (kern.osreldate), not of the headers. For io_uring it also holds
+ * the IORING_FEAT_* flags and the supported opcodes
+ * (gd_io_uring_has_opcode(opcode)). gd_io_direct_supported(path) checks if a
+ * file, or new files in a directory, can be opened with O_DIRECT.
+ *
+ * Synchronization:
+ * gd_sync_info() confirms the GD_HAS_* synchronization primitives at runtime, as
+ * GD_SYNC_* flags (check them with gd_sync_has(capabilities)). On Linux each
+ * syscall is called with harmless arguments, so futex, futex_waitv, futex2,
+ * membarrier, rseq and getcpu are only reported when the kernel has them and no
+ * seccomp filter blocks them. It also holds the MEMBARRIER_CMD_* commands the
+ * kernel supports, and GD_SYNC_RSEQ_LIBC when glibc registered rseq itself. On
+ * Windows WaitOnAddress is looked up, so it works with older SDKs.
+ *
+ * Snapshot:
+ * Probing reads many files in /proc and /sys and calibrates the cycle counter,
+ * which takes milliseconds. gd_snapshot_save(path) writes the CPU features and
+ * model, the cycle counter frequency, caches, topology, pages, limits and
+ * virtualization info to a file (GD_SNAPSHOT_PATH if path is NULL), and
+ * gd_snapshot_load(path) maps it and fills the caches that were not probed yet,
+ * so short lived processes skip the probing. A snapshot is only used when it is
+ * owned by root or the user, was written by a build with the same layout, and
+ * the boot id, kernel, CPU signature, cgroups and CPU affinity still match,
+ * otherwise the values are probed as usual. gd_snapshot_use(path) loads it, or
+ * probes and saves one for the next process. Changes to the cgroup limits
+ * themselves are not noticed, remove the snapshot after changing them. Only
+ * supported on Linux, FreeBSD, DragonFly BSD, NetBSD and Apple.
+ *
+ * ISA check:
+ * A binary compiled for newer extensions than the CPU has crashes with an illegal
+ * instruction somewhere deep in the code. gd_isa_check(check) compares the
+ * features the calling file is compiled for (gd_cpu_features_baseline()) with the
+ * running CPU and fills in the missing ones, the unused ones and on x86_64 the
+ * microarchitecture level of both (gd_isa_level(features), 1 to 4 as in
+ * -march=x86-64-v4). gd_isa_below_host(check) tells if the CPU could run a
+ * better build and gd_isa_report(check, buffer, size) describes the result in
+ * one line, with the -march to use. gd_isa_verify(flags) does all of that,
+ * writes the report to stderr and aborts if anything is missing (unless flags
+ * has GD_ISA_VERIFY_NO_ABORT), GD_ISA_VERIFY_SUGGEST also reports builds below
+ * the CPU. Setting GD_ISA_CHECK_AT_STARTUP to 1 (or 2 for the suggestions) in
+ * the implementation file runs it before main, with the flags of that file.
  *
  * Library options:
  *  - GD_ANDROID_IS_NOT_LINUX - do not define GD_OS_LINUX if building for Android
@@ -145,537 +503,36 @@
  *    inaccuracies and inability to detect some platfors
  *  - GD_NO_LIBC_DETECTION - do not try to detect the libc, on some exotic
  *    platforms this may cause issues
+ *  - GD_IMPLEMENTATION - define in exactly one source file before including
+ *    this header to compile the runtime detection functions
+ *  - GD_API - the linkage of the runtime detection functions, extern by default
+ *  - GD_ISA_CHECK_AT_STARTUP - verify the ISA baseline before main, see ISA check
+ *  - GD_DISPATCH_IFUNC - use GNU indirect functions for GD_DISPATCH, see
+ *    Function dispatch
  */
 
 #ifndef GENERIC_DETECT_H_
 #define GENERIC_DETECT_H_
 
-/* Options */
-
-/* Do not detect android as linux */
-#ifndef GD_ANDROID_IS_NOT_LINUX
-    #define GD_ANDROID_IS_NOT_LINUX 0
-#endif
-
-/* Do not use #warning */
-#ifndef GD_NO_CUSTOM_WARNINGS
-    #define GD_NO_CUSTOM_WARNINGS 0
-#endif
-
-/* Do not use #include */
-#ifndef GD_NO_EXTERNAL_INCLUDES
-    #define GD_NO_EXTERNAL_INCLUDES 0
-
-    /* Disallow detecting the LibC without external includes */
-    #ifdef GD_NO_LIBC_DETECTION
-        #if GD_NO_LIBC_DETECTION
-            #if !GD_NOT_CUSTOM_WARNINGS
-                #warning "Detect the LibC is not allowed without external includes"
-            #endif
-        #endif
-        #undef GD_NO_LIBC_DETECTION
-    #endif
-    #define GD_NO_LIBC_DETECTION 0
-#endif
-
-/* Do not detect the LibC */
-#ifndef GD_NO_LIBC_DETECTION
-    #define GD_NO_LIBC_DETECTION 0
-#endif
-
-/* Versioning */
-#define GD_MAKE_VERSION(major,minor,patch) (((major) << 24) + ((minor) << 16) + (patch))
-#define GD_VERSION_MAJOR(version) (version >> 24)
-#define GD_VERSION_MINOR(version) ((version >> 16) & 0xFF)
-#define GD_VERSION_PATCH(version) (version & 0xFFFF)
-
-/* Compiler detection */
-
-#define GD_IS_COMPILER(compiler) (defined(GD_COMPILER_##compiler))
-
-#ifdef __clang__ /* Clang */
-    #define GD_COMPILER_CLANG
-    #define GD_COMPILER_NAME "Clang"
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__clang_major__, __clang_minor__, __clang_patchlevel__)
-#endif
-
-#if defined(__MWERKS__) || defined(__CWCC__) /* CodeWarrior */
-    #define GD_COMPILER_CODEWARRIOR
-    #define GD_COMPILER_NAME "CodeWarrior"
-    #if __MWERKS__ == 1
-        #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
-    #else
-        #define GD_COMPILER_VERSION GD_MAKE_VERSION(__MWERKS__ >> 24, (__MWERKS__ >> 16) & 8, __MWERKS__ & 16)
-    #endif
-#endif
-
-#ifdef __DMC__ /* Digital Mars */
-    #define GD_COMPILER_DIGITALMARS
-    #define GD_COMPILER_NAME "Digital Mars"
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__DMC__ >> 16, (__DMC__ >> 8) & 8, __DMC__ & 8)
-#endif
-
-#ifdef __ghs__ /* Green Hill C/C++ */
-    #define GD_COMPILER_GREEN_HILL
-    #define GD_COMPILER_NAME "Green Hill C/C++"
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GHS_VERSION_NUMBER__ / 100, (__GHS_VERSION_NUMBER__ / 10) % 10, __GHS_VERSION_NUMBER__ % 10)
-#endif
-
-#if defined(__INTEL_COMPILER) || defined(__ICC) || defined(__ECC) || defined(__ICL) /* ICC */
-    #define GD_COMPILER_ICC
-    #define GC_COMPILER_NAME "ICC"
-    #define GD_COMPILER_VERSION (__INTEL_COMPILER < 2000 ? GD_MAKE_VERSION(__INTEL_COMPILER / 100, __INTEL_COMPILER % 100, __INTEL_COMPILER_UPDATE) : GD_MAKE_VERSION(__INTEL_COMPILER, __INTEL_COMPILER_UPDATE, 0))
-#endif
-
-/* NOTE: This is not in order for a reason, because Clang and ICC also define __GNUC__ */
-#ifdef __GNUC__ /* GCC */
-    #ifndef GD_COMPILER_NAME
-        #define GD_COMPILER_GCC
-        #define GD_COMPILER_NAME "GCC"
-        #ifndef __GNUC_MINOR__
-            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, 0, 0)
-        #elif !defined(__GNUC_PATCHLEVEL__)
-            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, __GNUC_MINOR__, 0)
-        #else
-            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__)
-        #endif
-    #endif
-#endif
-
-#ifdef _MSC_VER /* MSVC / Visual Studio */
-    #ifndef GD_COMPILER_NAME
-        #define GD_COMPILER_MSVC
-        #define GD_COMPILER_NAME "MSVC"
-        #ifdef _MSC_FULL_VER
-            #define GD_COMPILER_VERSION (_MSC_FULL_VER < 100000000 ? GD_MAKE_VERSION(_MSC_FULL_VER / 1000000, (_MSC_FULL_VER % 1000000) / 10000, _MSC_FULL_VER % 10000) : GD_MAKE_VERSION(_MSC_FULL_VER / 10000000, (_MSC_FULL_VER % 10000000) / 10000, _MSC_FULL_VER % 100000))
-        #else
-            #define GD_COMPILER_VERSION GD_MAKE_VERSION(_MSC_VER / 100, _MSC_VER % 100, 0)
-        #endif
-    #endif
-#endif
-
-#if defined(__SDCC) || defined(SDCC) /* SDCC */
-    #define GD_COMPILER_SDCC
-    #define GD_COMPILER_NAME "SDCC"
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__SDCC_VERSION_MAJOR, __SDCC_VERSION_MINOR, __SDCC_VERSION_PATCH)
-#endif
-
-#ifndef GD_COMPILER_NAME
-    #if !GD_NO_CUSTOM_WARNINGS
-        #warning "Unknown compiler"
-    #endif
-    #define GD_COMPILER_NAME "Unknown"
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
-#endif
-
-#ifndef GD_COMPILER_VERSION
-    #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
-#endif
-
-/* OS detection */
-
-#define GD_IS_OS(os) (defined(GD_OS_##os))
-
-#if defined(____386BSD____) || defined(__386BSD__) /* 386BSD */
-    #define GD_OS_386BSD
-    #define GD_OS_GENERIC_BSD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "386BSD"
-#endif
-
-#if defined(_AIX) || defined(__TOS_AIX__) /* AIX */
-    #define GD_OS_AIX
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "AIX"
-#endif
-
-#ifdef AMIX /* Amiga Unix / AMIX */
-    #define GD_OS_AMIX
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "Amiga Unix"
-#endif
-
-#ifdef __ANDROID__ /* Android */
-    #define GD_OS_ANDROID
-    #if !GD_ANDROID_IS_NOT_LINUX
-        #define GD_OS_LINUX
-    #endif
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "Android"
-#endif
-
-#ifdef __BEOS__ /* BeOS */
-    #define GD_OS_BEOS
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "BeOS"
-#endif
-
-#ifdef __DragonFly__ /* DragonFly BSD */
-    #define GD_OS_DRAGONFLY
-    #define GD_OS_GENERIC_BSD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "DragonFly BSD"
-#endif
-
-#if defined(__FreeBSD__) || defined(__FreeBSD_kernel__) /* FreeBSD */
-    #define GD_OS_FREEBSD
-    #define GD_OS_GENERIC_BSD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "FreeBSD"
-#endif
-
-#ifdef __gnu_hurd__ /* GNU/Hurd */
-    #define GD_OS_HURD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "GNU/Hurd"
-#endif
-
-#if defined(_hpux) || defined(hpux) || defined(__hpux) /* HP-UX */
-    #define GD_OS_HPUX
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "HP-UX"
-#endif
-
-#if defined(sgi) || defined(__sgi) /* IRIX */
-    #define GD_OS_IRIX
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "IRIX"
-#endif
-
-#if defined(__linux__) || defined(linux) || defined(__linux) /* Linux */
-    #if !(defined(GD_OS_ANDROID) && GD_ANDROID_IS_NOT_LINUX)
-        #define GD_OS_LINUX
-        #define GD_OS_GENERIC_UNIX
-    #endif
-    #ifndef GD_OS_NAME
-        #define GD_OS_NAME "Linux"
-    #endif
-#endif
-
-#if (defined(__APPLE__) && defined(__MACH__)) || defined(macintosh) || defined(Macintosh) /* MacOS */
-        #define GD_OS_MACOS
-        #define GD_OS_GENERIC_APPLE
-        #define GD_OS_GENERIC_UNIX
-        #define GD_OS_NAME "MacOS"
-#elif defined(__APPLE__) && !GD_NO_EXTERNAL_INCLUDES
-    #include <TargetConditionals.h>
-    #if TARGET_IPHONE_SIMULATOR
-        #define GD_OS_IPHONE_SIMULATOR
-        #define GD_OS_GENERIC_APPLE
-        #define GD_OS_NAME "IPhone Simulator"
-    #elif TARGET_OS_MACCATALYST
-        #define GD_OS_MACCATALYST
-        #define GD_OS_GENERIC_APPLE
-        #define GD_OS_NAME "Mac Catalyst"
-    #elif TARGET_OS_IPHONE
-        #define GD_OS_IOS
-        #define GD_OS_GENERIC_APPLE
-        #define GD_OS_NAME "iOS"
-    #else
-        #if !GD_NO_CUSTOM_WARNINGS
-            #warning "Unknown architecture"
-        #endif
-    #endif
-#endif
-
-#ifdef __minix /* MINIX */
-    #define GD_OS_MINIX
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "MINIX"
-#endif
-
-#if defined(MSDOS) || defined(__MSDOS__) || defined(_MSDOS) || defined(__DOS__) /* MS-DOS */
-    #define GD_OS_MSDOS
-    #define GD_OS_NAME "MS-DOS"
-#endif
-
-#ifdef __NetBSD__ /* NetBSD */
-    #define GD_OS_NETBSD
-    #define GD_OS_GENERIC_BSD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "NetBSD"
-#endif
-
-#ifdef NeXT /* NeXTSTEP */
-    #define GD_OS_NEXTSTEP
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "NeXTSTEP"
-#endif
-
-#ifdef __OpenBSD__ /* OpenBSD */
-    #define GD_OS_OPENBSD
-    #define GD_OS_GENERIC_BSD
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "OpenBSD"
-#endif
-
-#if defined(OS2) || defined(_OS2) || defined(__OS2__) || defined(__TOS_OS2__) /* OS/2 */
-    #define GD_OS_OS2
-    #define GD_OS_NAME "OS/2"
-#endif
-
-#if defined(EPLAN9) /* Plan 9 */
-    #define GD_OS_PLAN9
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "Plan 9"
-#endif
-
-#ifdef __serenity__ /* SerenityOS */
-    #define GD_OS_SERENITY
-    #define GD_OS_GENERIC_UNIX
-    #define GD_OS_NAME "SerenityOS"
-#endif
-
-#if defined(sun) || defined(__sun) /* Solaris / SunOS */
-    #define GD_OS_GENERIC_SUN
-    #define GD_OS_GENERIC_UNIX
-    #if defined(__illumos__)
-        #define GD_OS_ILLUMOS
-        #define GD_OS_NAME "illumos"
-    #elif defined(__SVR4) || defined(__svr4__)
-        #define GD_OS_SOLARIS
-        #define GD_OS_NAME "Solaris"
-    #else
-        #define GD_OS_SUNOS
-        #define GD_OS_NAME "SunOS"
-    #endif
-#endif
-
-#if defined(_WIN16) || defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__TOS_WIN__) || defined(__WINDOWS__) /* Windows */
-    #define GD_OS_WINDOWS
-    #define GD_OS_NAME "Windows"
-#endif
-
-#ifndef GD_OS_NAME
-    #if defined(__sysv__) || defined(__SVR4) || defined(__svr4__) || defined(_SYSTYPE_SVR4) /* Generic System V Unix*/
-        #define GD_OS_GENERIC_UNIX
-        #define GD_OS_NAME "Unknown System V Unix"
-    #elif defined(__unix__) || defined(__unix) || defined(unix) || defined(_POSIX_VERSION) || defined(_XOPEN_VERSION) || defined(_XOPEN_UNIX) /* Generic Unix */
-        #define GD_OS_GENERIC_UNIX
-        #define GD_OS_NAME "Unknown Unix"
-    #else
-        #if !GD_NO_CUSTOM_WARNINGS
-            #warning "Unknown operating system"
-        #endif
-        #define GD_OS_NAME "Unknown"
-    #endif
-#endif
-
-#if defined(GD_OS_GENERIC_UNIX)
-#define GD_IS_OS_UNIX 1
-#else
-#define GD_IS_OS_UNIX 0
-#endif
-
-#if defined(GD_OS_GENERIC_BSD)
-#define GD_IS_OS_BSD 1
-#else
-#define GD_IS_OS_BSD 0
-#endif
-
-#if defined(GD_OS_GENERIC_SUN)
-#define GD_IS_OS_SUN 1
-#else
-#define GD_IS_OS_SUN 0
-#endif
-
-#if defined(GD_OS_GENERIC_APPLE)
-#define GD_IS_OS_APPLE 1
-#else
-#define GD_IS_OS_APPLE 0
-#endif
-
-/* Archictecture detection */
-
-#define GD_IS_ARCH(arch) (defined(GD_ARCH_##arch))
-
-#if defined(__aarch64__) || defined(_M_ARM64) /* AArch64 */
-    #define GD_ARCH_AARCH64
-    #define GD_ARCH_NAME "AArch64"
-    #define GD_BITS 64
-#endif
-
-#if defined(__alpha__) || defined(__alpha) || defined(_M_ALPHA) /* Alpha */
-    #define GD_ARCH_ALPHA
-    #define GD_ARCH_NAME "Alpha"
-    #define GD_BITS 64
-#endif
-
-#if defined(__arm__) || defined(__thumb__) || defined(__TARGET_ARCH_ARM) \
-  || defined(__TARGET_ARCH_THUMB) || defined(_ARM) || defined(_M_ARM) \
-  || defined(_M_ARMT) || defined(__arm) || defined(arm) || defined(__arm32__) \
-  || defined(arm32) /* ARM */
-    #define GD_ARCH_ARM
-    #define GD_ARCH_NAME "ARM"
-    #define GD_BITS 32
-#endif
-
-#ifdef __convex__ /* Convex */
-    #define GD_ARCH_CONVEX
-    #define GD_ARCH_NAME "Convex"
-#endif
-
-#if defined(__hppa__) || defined(__HPPA__) || defined(__hppa) /* HPPA */
-    #define GD_ARCH_HPPA
-    #define GD_ARCH_NAME "HPPA"
-#endif
-
-#if defined(__ia64__) || defined(_IA64) || defined(__IA64__) || defined(__ia64) \
- || defined(_M_IA64) || defined(__itanium__) /* Itanium */
-    #define GD_ARCH_ITANIUM
-    #define GD_ARCH_NAME "Itanium"
-    #define GD_BITS 64
-#endif
-
-#ifdef __loongarch__ /* LoongArch */
-    #define GD_ARCH_LOONGARCH
-    #define GD_ARCH_NAME "LoongArch"
-    #define GD_BITS __loongarch_grlen
-#endif
-
-#if defined(__mips__) || defined(mips) || defined(__mips) || defined(__MIPS__) /* MIPS */
-    #define GD_ARCH_MIPS
-    #if defined(__LP64__) || defined(_LP64)
-        #define GD_ARCH_MIPS64
-        #define GD_ARCH_NAME "MIPS64"
-        #define GD_BITS 64
-    #else
-        #define GD_ARCH_MIPS32
-        #define GD_ARCH_NAME "MIPS"
-        #define GD_BITS 32
-    #endif
-#endif
-
-#if defined(__m68k__) || defined(M68000) || defined(__MC68K__) || defined(mc68000) || defined(m68k) \
- || defined(m68) || defined(mc68k) /* Motorola 68k */
-    #define GD_ARCH_M68K
-    #define GD_ARCH_NAME "Motorola 68k"
-#endif
-
-#if defined(__powerpc64__) || defined(__ppc64__) || defined(__PPC64__) || defined(_ARCH_PPC64) /* PowerPC64 */
-    #define GD_ARCH_POWERPC
-    #define GD_ARCH_POWERPC64
-    #define GD_ARCH_NAME "PowerPC64"
-    #define GD_BITS 64
-#elif defined(__powerpc) || defined(__powerpc__) || defined(__POWERPC__) || defined(__ppc__) \
-   || defined(__PPC__) || defined(_ARCH_PPC) /* PowerPC */
-    #define GD_ARCH_POWERPC
-    #define GD_ARCH_POWERPC32
-    #define GD_ARCH_NAME "PowerPC"
-    #define GD_BITS 32
-#endif
-
-#ifdef __riscv /* RISC-V */
-    #define GD_ARCH_RISCV
-    #define GD_ARCH_NAME "RISC-V"
-    #if defined(__riscv_32len)
-        #define GD_ARCH_RISCV32
-        #define GD_ARCH_VERSION_NAME "RISC-V 32"
-        #define GD_BITS 32
-    #elif defined(__riscv_64len)
-        #define GD_ARCH_RISCV64
-        #define GD_ARCH_VERSION_NAME "RISC-V 64"
-        #define GD_BITS 64
-    #endif
-#endif
-
-#if defined(__sparc__) || defined(__sparc) /* SPARC */
-    #define GD_ARCH_SPARC
-    #define GD_ARCH_NAME "SPARC"
-#endif
-
-#if defined(i386) || defined(__i386) || defined(__i386__) || defined(__IA32__) \
- || defined(_M_I86) || defined(_M_IX86) || defined(__X86__) || defined(_X86_) \
- || defined(__THW_INTEL__) || defined(__I86__) || defined(__INTEL__) || defined(__386) \
- || defined(_I386) || defined(sun386) /* x86 */
-    #define GD_ARCH_X86
-    #define GD_ARCH_NAME "x86"
-    #if defined(__i686__) || _M_IX86 == 600 || __I86__ == 6
-        #define GD_ARCH_I686
-        #define GD_ARCH_VERSION 6
-        #define GD_ARCH_VERSION_NAME "i686"
-        #define GD_BITS 32
-    #elif defined(__i585__) || _M_IX86 == 500 || __I86__ == 5
-        #define GD_ARCH_I586
-        #define GD_ARCH_VERSION 5
-        #define GD_ARCH_VERSION_NAME "i586"
-        #define GD_BITS 32
-    #elif defined(__i486__) || _M_IX86 == 400 || __I86__ == 4
-        #define GD_ARCH_I486
-        #define GD_ARCH_VERSION 4
-        #define GD_ARCH_VERSION_NAME "i486"
-        #define GD_BITS 32
-    #elif defined(__i386__) || _M_IX86 == 300 || __I86__ == 3
-        #define GD_ARCH_I386
-        #define GD_ARCH_VERSION 3
-        #define GD_ARCH_VERSION_NAME "i386"
-        #define GD_BITS 32
-    #elif defined(__386__) || defined(_M_I386)
-        #define GD_BITS 32
-    #elif defined(_M_I86)
-        #define GD_BITS 16
-    #else
-        #if !GD_NO_CUSTOM_WARNINGS
-            #warning "Failed to identify x86 bit count, assuming 32..."
-        #endif
-        #define GD_BITS 32
-    #endif
-#endif
-
-#if defined(__amd64__) || defined(__amd64) || defined(__x86_64__) || defined(__x86_64) \
- || defined(_M_X64) || defined(_M_AMD64) /* x86_64 */
-    #define GD_ARCH_X86_64
-    #define GD_ARCH_NAME "x86_64"
-    #define GD_BITS 64
-#endif
-
-#ifndef GD_ARCH_NAME
-    #if !GD_NO_CUSTOM_WARNINGS
-        #warning "Unknown architecture"
-    #endif
-    #define GD_ARCH_NAME "Unknown"
-#endif
-
-#ifndef GD_ARCH_VERSION
-    #define GD_ARCH_VERSION 1
-    #define GD_ARCH_VERSION_NAME ""
-#endif
-
-#if !defined(GD_BITS) && (defined(__LP64__) || defined(_LP64))
-    #define GD_BITS 64
-#endif
-
-#ifndef GD_BITS
-    #define GD_BITS -1
-#endif
-
-/* LibC detection */
-
-#if !GD_NO_LIBC_DETECTION
-#ifndef __has_include
-#define __has_include() 0
-#endif
-
-#if __has_include(<features.h>)
-#include <features.h>
-#else
-#include <limits.h>
-#endif
-
-#if defined(__GLIBC__) || defined(__GNU_LIBRARY__)
-    #define GD_LIBC_GLIBC
-    #define GD_LIBC_NAME "glibc"
-    #ifdef __GLIBC__
-        #define GD_LIBC_VERSION GD_MAKE_VERSION(__GLIBC__, __GLIBC_MINOR__, 0)
-    #else
-        #define GD_LIBC_VERSION GD_MAKE_VERSION(__GNU_LIBRARY__, __GNU_LIBRARY_MINOR__, 0)
-    #endif
-#endif
-#endif
-
-#ifndef GD_LIBC_NAME
-    #define GD_LIBC_NAME "Unknown"
-    #define GD_LIBC_VERSION GD_MAKE_VERSION(1, 0, 0)
-#endif
-
+#include "GenericDetect/Base.h"
+#include "GenericDetect/Compiler.h"
+#include "GenericDetect/OS.h"
+#include "GenericDetect/Arch.h"
+#include "GenericDetect/Build.h"
+#include "GenericDetect/SIMD.h"
+#include "GenericDetect/Endian.h"
+#include "GenericDetect/Memory.h"
+#include "GenericDetect/ABI.h"
+#include "GenericDetect/LibC.h"
+#include "GenericDetect/Language.h"
+#include "GenericDetect/Hints.h"
+#include "GenericDetect/Bits.h"
+#include "GenericDetect/Atomics.h"
+#include "GenericDetect/Sync.h"
+#include "GenericDetect/Runtime.h"
+
+#endif
+
+#ifdef GD_IMPLEMENTATION
+#include "GenericDetect/Implementation.h"
 #endif
@@ -0,0 +1,521 @@
+/*
+ * GenericDetect - constexpr C++ interface
+ *
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ *
+ * The detection macros as C++11 constants in the gd namespace, so they can be
+ * used in templates and if constexpr instead of #if blocks, e.g.:
+ *
+ *   if constexpr (gd::arch == gd::Arch::AArch64 && gd::compiler_version >= gd::version(12, 0, 0))
+ *
+ *  - gd::Version - a version in the GD_MAKE_VERSION format, with comparisons
+ *    and major(), minor() and patch(), created with gd::version(major, minor, patch)
+ *  - gd::compiler, gd::compiler_version - gd::Compiler and its version
+ *  - gd::os - gd::OS, the most specific one (e.g. Android instead of Linux),
+ *    with gd::os_unix, gd::os_bsd, gd::os_sun and gd::os_apple for the groups
+ *  - gd::arch, gd::arch_version, gd::bits - gd::Arch, GD_ARCH_VERSION and GD_BITS
+ *  - gd::data_model, gd::max_align - gd::DataModel and GD_MAX_ALIGN
+ *  - gd::libc, gd::libc_version - gd::LibC and its version
+ *  - gd::endian - gd::Endian
+ *  - gd::simd, gd::simd_width_bits - the widest gd::Simd extension and its
+ *    register width, gd::has_simd(gd::Simd) checks for any extension
+ *
+ * Every constant also has a trait type for template arguments and
+ * specialization: gd::compiler_t, gd::os_t, gd::arch_t, gd::data_model_t,
+ * gd::libc_t, gd::bit_width_t, gd::simd_t and gd::simd_supported<gd::Simd>, all with a
+ * static value member.
+ */
+
+#ifndef GENERIC_DETECT_HPP_
+#define GENERIC_DETECT_HPP_
+
+#include "GenericDetect.h"
+
+#if GD_CXX_STANDARD < 2011
+    #error "GenericDetect.hpp needs C++11 or newer"
+#endif
+
+namespace gd
+{
+
+/* Versions */
+
+class Version
+{
+public:
+    constexpr explicit Version(unsigned int value) : m_value(value) {}
+
+    constexpr unsigned int value() const { return m_value; }
+    constexpr unsigned int major() const { return GD_VERSION_MAJOR(m_value); }
+    constexpr unsigned int minor() const { return GD_VERSION_MINOR(m_value); }
+    constexpr unsigned int patch() const { return GD_VERSION_PATCH(m_value); }
+
+    constexpr bool operator==(Version other) const { return m_value == other.m_value; }
+    constexpr bool operator!=(Version other) const { return m_value != other.m_value; }
+    constexpr bool operator<(Version other) const { return m_value < other.m_value; }
+    constexpr bool operator<=(Version other) const { return m_value <= other.m_value; }
+    constexpr bool operator>(Version other) const { return m_value > other.m_value; }
+    constexpr bool operator>=(Version other) const { return m_value >= other.m_value; }
+
+private:
+    unsigned int m_value;
+};
+
+constexpr Version version(unsigned int major, unsigned int minor, unsigned int patch)
+{
+    return Version(GD_MAKE_VERSION(major, minor, patch));
+}
+
+/* Trait base, like std::integral_constant but without including <type_traits> */
+template <typename T, T V>
+struct constant
+{
+    typedef T value_type;
+    static constexpr T value = V;
+    constexpr operator T() const { return V; }
+};
+
+template <typename T, T V>
+constexpr T constant<T, V>::value;
+
+/* Compiler */
+
+enum class Compiler
+{
+    Unknown,
+    Clang,
+    CodeWarrior,
+    DigitalMars,
+    GCC,
+    GreenHill,
+    ICC,
+    MSVC,
+    SDCC
+};
+
+constexpr Compiler compiler =
+#if defined(GD_COMPILER_CLANG)
+    Compiler::Clang;
+#elif defined(GD_COMPILER_CODEWARRIOR)
+    Compiler::CodeWarrior;
+#elif defined(GD_COMPILER_DIGITALMARS)
+    Compiler::DigitalMars;
+#elif defined(GD_COMPILER_GCC)
+    Compiler::GCC;
+#elif defined(GD_COMPILER_GREEN_HILL)
+    Compiler::GreenHill;
+#elif defined(GD_COMPILER_ICC)
+    Compiler::ICC;
+#elif defined(GD_COMPILER_MSVC)
+    Compiler::MSVC;
+#elif defined(GD_COMPILER_SDCC)
+    Compiler::SDCC;
+#else
+    Compiler::Unknown;
+#endif
+
+constexpr Version compiler_version = Version(GD_COMPILER_VERSION);
+constexpr const char* compiler_name = GD_COMPILER_NAME;
+
+typedef constant<Compiler, compiler> compiler_t;
+
+/* Operating system */
+
+enum class OS
+{
+    Unknown,
+    BSD386,
+    AIX,
+    AmigaUnix,
+    Android,
+    BeOS,
+    DragonFly,
+    FreeBSD,
+    Hurd,
+    HPUX,
+    Illumos,
+    IOS,
+    IPhoneSimulator,
+    IRIX,
+    Linux,
+    MacCatalyst,
+    MacOS,
+    MINIX,
+    MSDOS,
+    NetBSD,
+    NeXTSTEP,
+    OpenBSD,
+    OS2,
+    Plan9,
+    Serenity,
+    Solaris,
+    SunOS,
+    Windows
+};
+
+/* NOTE: Android also defines GD_OS_LINUX, so it is checked first */
+constexpr OS os =
+#if defined(GD_OS_ANDROID)
+    OS::Android;
+#elif defined(GD_OS_LINUX)
+    OS::Linux;
+#elif defined(GD_OS_WINDOWS)
+    OS::Windows;
+#elif defined(GD_OS_MACOS)
+    OS::MacOS;
+#elif defined(GD_OS_IOS)
+    OS::IOS;
+#elif defined(GD_OS_IPHONE_SIMULATOR)
+    OS::IPhoneSimulator;
+#elif defined(GD_OS_MACCATALYST)
+    OS::MacCatalyst;
+#elif defined(GD_OS_FREEBSD)
+    OS::FreeBSD;
+#elif defined(GD_OS_NETBSD)
+    OS::NetBSD;
+#elif defined(GD_OS_OPENBSD)
+    OS::OpenBSD;
+#elif defined(GD_OS_DRAGONFLY)
+    OS::DragonFly;
+#elif defined(GD_OS_386BSD)
+    OS::BSD386;
+#elif defined(GD_OS_ILLUMOS)
+    OS::Illumos;
+#elif defined(GD_OS_SOLARIS)
+    OS::Solaris;
+#elif defined(GD_OS_SUNOS)
+    OS::SunOS;
+#elif defined(GD_OS_AIX)
+    OS::AIX;
+#elif defined(GD_OS_AMIX)
+    OS::AmigaUnix;
+#elif defined(GD_OS_BEOS)
+    OS::BeOS;
+#elif defined(GD_OS_HURD)
+    OS::Hurd;
+#elif defined(GD_OS_HPUX)
+    OS::HPUX;
+#elif defined(GD_OS_IRIX)
+    OS::IRIX;
+#elif defined(GD_OS_MINIX)
+    OS::MINIX;
+#elif defined(GD_OS_MSDOS)
+    OS::MSDOS;
+#elif defined(GD_OS_NEXTSTEP)
+    OS::NeXTSTEP;
+#elif defined(GD_OS_OS2)
+    OS::OS2;
+#elif defined(GD_OS_PLAN9)
+    OS::Plan9;
+#elif defined(GD_OS_SERENITY)
+    OS::Serenity;
+#else
+    OS::Unknown;
+#endif
+
+constexpr const char* os_name = GD_OS_NAME;
+constexpr bool os_unix = GD_IS_OS_UNIX != 0;
+constexpr bool os_bsd = GD_IS_OS_BSD != 0;
+constexpr bool os_sun = GD_IS_OS_SUN != 0;
+constexpr bool os_apple = GD_IS_OS_APPLE != 0;
+
+typedef constant<OS, os> os_t;
+
+/* Architecture */
+
+enum class Arch
+{
+    Unknown,
+    AArch64,
+    Alpha,
+    ARM,
+    Convex,
+    HPPA,
+    Itanium,
+    LoongArch,
+    M68K,
+    MIPS,
+    PowerPC,
+    RISCV,
+    SPARC,
+    X86,
+    X86_64
+};
+
+constexpr Arch arch =
+#if defined(GD_ARCH_X86_64)
+    Arch::X86_64;
+#elif defined(GD_ARCH_X86)
+    Arch::X86;
+#elif defined(GD_ARCH_AARCH64)
+    Arch::AArch64;
+#elif defined(GD_ARCH_ARM)
+    Arch::ARM;
+#elif defined(GD_ARCH_RISCV)
+    Arch::RISCV;
+#elif defined(GD_ARCH_POWERPC)
+    Arch::PowerPC;
+#elif defined(GD_ARCH_LOONGARCH)
+    Arch::LoongArch;
+#elif defined(GD_ARCH_MIPS)
+    Arch::MIPS;
+#elif defined(GD_ARCH_SPARC)
+    Arch::SPARC;
+#elif defined(GD_ARCH_ALPHA)
+    Arch::Alpha;
+#elif defined(GD_ARCH_ITANIUM)
+    Arch::Itanium;
+#elif defined(GD_ARCH_HPPA)
+    Arch::HPPA;
+#elif defined(GD_ARCH_M68K)
+    Arch::M68K;
+#elif defined(GD_ARCH_CONVEX)
+    Arch::Convex;
+#else
+    Arch::Unknown;
+#endif
+
+constexpr const char* arch_name = GD_ARCH_NAME;
+constexpr int arch_version = GD_ARCH_VERSION;
+constexpr int bits = GD_BITS; /* -1 if unknown */
+
+typedef constant<Arch, arch> arch_t;
+typedef constant<int, bits> bit_width_t;
+
+/* Data model */
+
+enum class DataModel
+{
+    Unknown,
+    LP64,
+    LLP64,
+    ILP32,
+    ILP32_X32
+};
+
+constexpr DataModel data_model =
+#if defined(GD_DATA_MODEL_LP64)
+    DataModel::LP64;
+#elif defined(GD_DATA_MODEL_LLP64)
+    DataModel::LLP64;
+#elif defined(GD_DATA_MODEL_ILP32_X32)
+    DataModel::ILP32_X32;
+#elif defined(GD_DATA_MODEL_ILP32)
+    DataModel::ILP32;
+#else
+    DataModel::Unknown;
+#endif
+
+constexpr int max_align = GD_MAX_ALIGN;
+
+typedef constant<DataModel, data_model> data_model_t;
+
+/* C library */
+
+enum class LibC
+{
+    Unknown,
+    Glibc,
+    Musl,
+    Bionic,
+    UClibc,
+    Newlib,
+    UCRT,
+    MSVCRT,
+    Apple,
+    BSD
+};
+
+constexpr LibC libc =
+#if defined(GD_LIBC_GLIBC)
+    LibC::Glibc;
+#elif defined(GD_LIBC_MUSL)
+    LibC::Musl;
+#elif defined(GD_LIBC_BIONIC)
+    LibC::Bionic;
+#elif defined(GD_LIBC_UCLIBC)
+    LibC::UClibc;
+#elif defined(GD_LIBC_NEWLIB)
+    LibC::Newlib;
+#elif defined(GD_LIBC_UCRT)
+    LibC::UCRT;
+#elif defined(GD_LIBC_MSVCRT)
+    LibC::MSVCRT;
+#elif defined(GD_LIBC_APPLE)
+    LibC::Apple;
+#elif defined(GD_LIBC_BSD)
+    LibC::BSD;
+#else
+    LibC::Unknown;
+#endif
+
+constexpr Version libc_version = Version(GD_LIBC_VERSION);
+constexpr const char* libc_name = GD_LIBC_NAME;
+
+typedef constant<LibC, libc> libc_t;
+
+/* Endianness */
+
+enum class Endian
+{
+    Unknown,
+    Little,
+    Big,
+    PDP
+};
+
+constexpr Endian endian =
+#if defined(GD_ENDIAN_LITTLE)
+    Endian::Little;
+#elif defined(GD_ENDIAN_BIG)
+    Endian::Big;
+#elif defined(GD_ENDIAN_PDP)
+    Endian::PDP;
+#else
+    Endian::Unknown;
+#endif
+
+/* SIMD */
+
+/* The x86 values are ordered, so gd::simd >= gd::Simd::AVX2 works as expected there */
+enum class Simd
+{
+    None,
+    SSE,
+    SSE2,
+    SSE3,
+    SSSE3,
+    SSE4_1,
+    SSE4_2,
+    AVX,
+    AVX2,
+    AVX512,
+    AVX10,
+    NEON,
+    SVE,
+    SVE2,
+    RVV,
+    AltiVec,
+    VSX,
+    LSX,
+    LASX
+};
+
+/* The widest extension, like GD_SIMD_NAME */
+constexpr Simd simd =
+#if defined(GD_SIMD_AVX10)
+    Simd::AVX10;
+#elif defined(GD_SIMD_AVX512F)
+    Simd::AVX512;
+#elif defined(GD_SIMD_AVX2)
+    Simd::AVX2;
+#elif defined(GD_SIMD_AVX)
+    Simd::AVX;
+#elif defined(GD_SIMD_SSE4_2)
+    Simd::SSE4_2;
+#elif defined(GD_SIMD_SSE4_1)
+    Simd::SSE4_1;
+#elif defined(GD_SIMD_SSSE3)
+    Simd::SSSE3;
+#elif defined(GD_SIMD_SSE3)
+    Simd::SSE3;
+#elif defined(GD_SIMD_SSE2)
+    Simd::SSE2;
+#elif defined(GD_SIMD_SSE)
+    Simd::SSE;
+#elif defined(GD_SIMD_SVE2)
+    Simd::SVE2;
+#elif defined(GD_SIMD_SVE)
+    Simd::SVE;
+#elif defined(GD_SIMD_NEON)
+    Simd::NEON;
+#elif defined(GD_SIMD_RVV)
+    Simd::RVV;
+#elif defined(GD_SIMD_VSX)
+    Simd::VSX;
+#elif defined(GD_SIMD_ALTIVEC)
+    Simd::AltiVec;
+#elif defined(GD_SIMD_LASX)
+    Simd::LASX;
+#elif defined(GD_SIMD_LSX)
+    Simd::LSX;
+#else
+    Simd::None;
+#endif
+
+constexpr const char* simd_name = GD_SIMD_NAME;
+constexpr int simd_width_bits = GD_SIMD_MAX_WIDTH_BITS;
+
+/* Every available extension as a bit indexed by gd::Simd */
+constexpr unsigned long long simd_mask = 1ull
+#ifdef GD_SIMD_SSE
+    | (1ull << static_cast<int>(Simd::SSE))
+#endif
+#ifdef GD_SIMD_SSE2
+    | (1ull << static_cast<int>(Simd::SSE2))
+#endif
+#ifdef GD_SIMD_SSE3
+    | (1ull << static_cast<int>(Simd::SSE3))
+#endif
+#ifdef GD_SIMD_SSSE3
+    | (1ull << static_cast<int>(Simd::SSSE3))
+#endif
+#ifdef GD_SIMD_SSE4_1
+    | (1ull << static_cast<int>(Simd::SSE4_1))
+#endif
+#ifdef GD_SIMD_SSE4_2
+    | (1ull << static_cast<int>(Simd::SSE4_2))
+#endif
+#ifdef GD_SIMD_AVX
+    | (1ull << static_cast<int>(Simd::AVX))
+#endif
+#ifdef GD_SIMD_AVX2
+    | (1ull << static_cast<int>(Simd::AVX2))
+#endif
+#ifdef GD_SIMD_AVX512F
+    | (1ull << static_cast<int>(Simd::AVX512))
+#endif
+#ifdef GD_SIMD_AVX10
+    | (1ull << static_cast<int>(Simd::AVX10))
+#endif
+#ifdef GD_SIMD_NEON
+    | (1ull << static_cast<int>(Simd::NEON))
+#endif
+#ifdef GD_SIMD_SVE
+    | (1ull << static_cast<int>(Simd::SVE))
+#endif
+#ifdef GD_SIMD_SVE2
+    | (1ull << static_cast<int>(Simd::SVE2))
+#endif
+#ifdef GD_SIMD_RVV
+    | (1ull << static_cast<int>(Simd::RVV))
+#endif
+#ifdef GD_SIMD_ALTIVEC
+    | (1ull << static_cast<int>(Simd::AltiVec))
+#endif
+#ifdef GD_SIMD_VSX
+    | (1ull << static_cast<int>(Simd::VSX))
+#endif
+#ifdef GD_SIMD_LSX
+    | (1ull << static_cast<int>(Simd::LSX))
+#endif
+#ifdef GD_SIMD_LASX
+    | (1ull << static_cast<int>(Simd::LASX))
+#endif
+    ;
+
+/* Simd::None is always supported */
+constexpr bool has_simd(Simd extension)
+{
+    return ((simd_mask >> static_cast<int>(extension)) & 1) != 0;
+}
+
+typedef constant<Simd, simd> simd_t;
+
+template <Simd Extension>
+struct simd_supported : constant<bool, has_simd(Extension)> {};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * GenericDetect - Data model and calling convention (GD_DATA_MODEL_*, GD_SIZEOF_*, GD_ABI_*)
+ *
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_ABI_H_
+#define GENERIC_DETECT_ABI_H_
+
+#include "Compiler.h"
+#include "OS.h"
+#include "Arch.h"
+#include "SIMD.h"
+#include "Hints.h"
+
+/* Type sizes */
+
+/* NOTE: GCC and Clang predefine the sizes, the rest is only known for the common targets */
+#ifndef GD_SIZEOF_POINTER
+    #if defined(__SIZEOF_POINTER__)
+        #define GD_SIZEOF_POINTER __SIZEOF_POINTER__
+    #elif defined(_WIN64)
+        #define GD_SIZEOF_POINTER 8
+    #elif defined(_WIN32)
+        #define GD_SIZEOF_POINTER 4
+    #elif defined(__LP64__) || defined(_LP64)
+        #define GD_SIZEOF_POINTER 8
+    #elif GD_BITS == 64 && !defined(__ILP32__)
+        #define GD_SIZEOF_POINTER 8
+    #elif GD_BITS == 32
+        #define GD_SIZEOF_POINTER 4
+    #else
+        #define GD_SIZEOF_POINTER -1
+    #endif
+#endif
+
+#ifndef GD_SIZEOF_LONG
+    #if defined(__SIZEOF_LONG__)
+        #define GD_SIZEOF_LONG __SIZEOF_LONG__
+    #elif defined(GD_OS_WINDOWS)
+        #define GD_SIZEOF_LONG 4
+    #elif defined(__LP64__) || defined(_LP64)
+        #define GD_SIZEOF_LONG 8
+    #else
+        #define GD_SIZEOF_LONG GD_SIZEOF_POINTER
+    #endif
+#endif
+
+#ifndef GD_SIZEOF_LONG_DOUBLE
+    #if defined(__SIZEOF_LONG_DOUBLE__)
+        #define GD_SIZEOF_LONG_DOUBLE __SIZEOF_LONG_DOUBLE__
+    #elif defined(_MSC_VER) || (defined(GD_ARCH_AARCH64) && defined(GD_OS_GENERIC_APPLE))
+        #define GD_SIZEOF_LONG_DOUBLE 8
+    #elif defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+        #define GD_SIZEOF_LONG_DOUBLE 16
+    #elif defined(GD_ARCH_X86)
+        #define GD_SIZEOF_LONG_DOUBLE 12
+    #else
+        #define GD_SIZEOF_LONG_DOUBLE 8
+    #endif
+#endif
+
+/* Data model */
+
+#if GD_SIZEOF_POINTER == 8 && GD_SIZEOF_LONG == 8
+    #define GD_DATA_MODEL_LP64
+    #define GD_DATA_MODEL_NAME "LP64"
+#elif GD_SIZEOF_POINTER == 8 && GD_SIZEOF_LONG == 4
+    #define GD_DATA_MODEL_LLP64
+    #define GD_DATA_MODEL_NAME "LLP64"
+#elif GD_SIZEOF_POINTER == 4 && GD_SIZEOF_LONG == 4
+    #define GD_DATA_MODEL_ILP32
+    #ifdef GD_ARCH_X86_64
+        #define GD_DATA_MODEL_ILP32_X32
+        #define GD_DATA_MODEL_NAME "ILP32 (x32)"
+    #else
+        #define GD_DATA_MODEL_NAME "ILP32"
+    #endif
+#else
+    #define GD_DATA_MODEL_NAME "Unknown"
+#endif
+
+/* Maximum fundamental alignment */
+
+/* NOTE: Matches alignof(max_align_t), MSVC (and clang-cl using its headers) only puts double in it */
+#ifndef GD_MAX_ALIGN
+    #if defined(_MSC_VER)
+        #define GD_MAX_ALIGN 8
+    #elif defined(GD_ARCH_M68K)
+        #define GD_MAX_ALIGN 2
+    #elif GD_SIZEOF_POINTER == 8 || defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+        #define GD_MAX_ALIGN 16
+    #elif defined(GD_ARCH_X86) || defined(GD_ARCH_POWERPC32) || defined(GD_ARCH_RISCV) || defined(GD_ARCH_LOONGARCH)
+        #define GD_MAX_ALIGN 16
+    #else
+        #define GD_MAX_ALIGN 8
+    #endif
+#endif
+
+/* Calling convention */
+
+#if defined(GD_ARCH_X86_64)
+    #if defined(GD_OS_WINDOWS) || defined(__CYGWIN__)
+        #define GD_ABI_WIN64
+        #define GD_ABI_NAME "Win64"
+    #else
+        #define GD_ABI_SYSV
+        #define GD_ABI_NAME "System V AMD64"
+    #endif
+#elif defined(GD_ARCH_X86)
+    #if defined(GD_OS_WINDOWS) || defined(__CYGWIN__)
+        #define GD_ABI_WIN32
+        #define GD_ABI_NAME "Win32"
+    #else
+        #define GD_ABI_SYSV
+        #define GD_ABI_NAME "System V i386"
+    #endif
+#elif defined(GD_ARCH_AARCH64)
+    #define GD_ABI_AAPCS64
+    /* Functions taking or returning SVE types pass them in the Z and P registers */
+    #ifdef GD_SIMD_SVE
+        #define GD_ABI_AAPCS64_SVE
+        #define GD_ABI_NAME "AAPCS64 (SVE)"
+    #else
+        #define GD_ABI_NAME "AAPCS64"
+    #endif
+#elif defined(GD_ARCH_ARM) && (defined(__ARM_EABI__) || defined(GD_OS_WINDOWS))
+    #define GD_ABI_AAPCS
+    #ifdef __ARM_PCS_VFP
+        #define GD_ABI_AAPCS_VFP
+        #define GD_ABI_NAME "AAPCS (VFP)"
+    #else
+        #define GD_ABI_NAME "AAPCS"
+    #endif
+#else
+    #define GD_ABI_NAME "Unknown"
+#endif
+
+/* __vectorcall passes up to 6 vectors and vector aggregates in registers, instead of 4 (Win64) or none (Win32) */
+#if (defined(GD_ABI_WIN64) || defined(GD_ABI_WIN32)) && (GD_INTERNAL_MSVC_VERSION >= 1800 || defined(GD_COMPILER_CLANG))
+    #define GD_HAS_VECTORCALL 1
+#else
+    #define GD_HAS_VECTORCALL 0
+#endif
+
+/*
+ * GD_VECTOR_CALL marks functions taking or returning vectors to use the vector
+ * calling convention of the target, goes between the return type and the name.
+ * On AArch64 the callee preserves all of v8-v23 instead of the low halves of
+ * v8-v15, so it pays off for small functions called from vector loops.
+ */
+#if GD_HAS_VECTORCALL
+    #define GD_HAS_VECTOR_PCS 1
+    #define GD_VECTOR_CALL __vectorcall
+#elif defined(GD_ABI_AAPCS64) && GD_HAS_ATTRIBUTE(aarch64_vector_pcs)
+    #define GD_HAS_VECTOR_PCS 1
+    #define GD_VECTOR_CALL __attribute__((aarch64_vector_pcs))
+#else
+    #define GD_HAS_VECTOR_PCS 0
+    #define GD_VECTOR_CALL
+#endif
+
+#endif
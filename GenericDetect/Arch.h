@@ -0,0 +1,184 @@
+/*
+ * GenericDetect - Architecture detection (GD_ARCH_*, GD_BITS)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_ARCH_H_
+#define GENERIC_DETECT_ARCH_H_
+
+#include "Base.h"
+
+/* Archictecture detection */
+
+#define GD_IS_ARCH(arch) (defined(GD_ARCH_##arch))
+
+#if defined(__aarch64__) || defined(_M_ARM64) /* AArch64 */
+    #define GD_ARCH_AARCH64
+    #define GD_ARCH_NAME "AArch64"
+    #define GD_BITS 64
+#endif
+
+#if defined(__alpha__) || defined(__alpha) || defined(_M_ALPHA) /* Alpha */
+    #define GD_ARCH_ALPHA
+    #define GD_ARCH_NAME "Alpha"
+    #define GD_BITS 64
+#endif
+
+#if defined(__arm__) || defined(__thumb__) || defined(__TARGET_ARCH_ARM) \
+  || defined(__TARGET_ARCH_THUMB) || defined(_ARM) || defined(_M_ARM) \
+  || defined(_M_ARMT) || defined(__arm) || defined(arm) || defined(__arm32__) \
+  || defined(arm32) /* ARM */
+    #define GD_ARCH_ARM
+    #define GD_ARCH_NAME "ARM"
+    #define GD_BITS 32
+#endif
+
+#ifdef __convex__ /* Convex */
+    #define GD_ARCH_CONVEX
+    #define GD_ARCH_NAME "Convex"
+#endif
+
+#if defined(__hppa__) || defined(__HPPA__) || defined(__hppa) /* HPPA */
+    #define GD_ARCH_HPPA
+    #define GD_ARCH_NAME "HPPA"
+#endif
+
+#if defined(__ia64__) || defined(_IA64) || defined(__IA64__) || defined(__ia64) \
+ || defined(_M_IA64) || defined(__itanium__) /* Itanium */
+    #define GD_ARCH_ITANIUM
+    #define GD_ARCH_NAME "Itanium"
+    #define GD_BITS 64
+#endif
+
+#ifdef __loongarch__ /* LoongArch */
+    #define GD_ARCH_LOONGARCH
+    #define GD_ARCH_NAME "LoongArch"
+    #define GD_BITS __loongarch_grlen
+#endif
+
+#if defined(__mips__) || defined(mips) || defined(__mips) || defined(__MIPS__) /* MIPS */
+    #define GD_ARCH_MIPS
+    #if defined(__LP64__) || defined(_LP64)
+        #define GD_ARCH_MIPS64
+        #define GD_ARCH_NAME "MIPS64"
+        #define GD_BITS 64
+    #else
+        #define GD_ARCH_MIPS32
+        #define GD_ARCH_NAME "MIPS"
+        #define GD_BITS 32
+    #endif
+#endif
+
+#if defined(__m68k__) || defined(M68000) || defined(__MC68K__) || defined(mc68000) || defined(m68k) \
+ || defined(m68) || defined(mc68k) /* Motorola 68k */
+    #define GD_ARCH_M68K
+    #define GD_ARCH_NAME "Motorola 68k"
+#endif
+
+#if defined(__powerpc64__) || defined(__ppc64__) || defined(__PPC64__) || defined(_ARCH_PPC64) /* PowerPC64 */
+    #define GD_ARCH_POWERPC
+    #define GD_ARCH_POWERPC64
+    #define GD_ARCH_NAME "PowerPC64"
+    #define GD_BITS 64
+#elif defined(__powerpc) || defined(__powerpc__) || defined(__POWERPC__) || defined(__ppc__) \
+   || defined(__PPC__) || defined(_ARCH_PPC) /* PowerPC */
+    #define GD_ARCH_POWERPC
+    #define GD_ARCH_POWERPC32
+    #define GD_ARCH_NAME "PowerPC"
+    #define GD_BITS 32
+#endif
+
+#ifdef __riscv /* RISC-V */
+    #define GD_ARCH_RISCV
+    #define GD_ARCH_NAME "RISC-V"
+    #if defined(__riscv_32len)
+        #define GD_ARCH_RISCV32
+        #define GD_ARCH_VERSION_NAME "RISC-V 32"
+        #define GD_BITS 32
+    #elif defined(__riscv_64len)
+        #define GD_ARCH_RISCV64
+        #define GD_ARCH_VERSION_NAME "RISC-V 64"
+        #define GD_BITS 64
+    #endif
+#endif
+
+#if defined(__sparc__) || defined(__sparc) /* SPARC */
+    #define GD_ARCH_SPARC
+    #define GD_ARCH_NAME "SPARC"
+    #if defined(__sparc_v9__) || defined(__sparcv9) || defined(__arch64__)
+        #define GD_BITS 64
+    #endif
+#endif
+
+#if defined(i386) || defined(__i386) || defined(__i386__) || defined(__IA32__) \
+ || defined(_M_I86) || defined(_M_IX86) || defined(__X86__) || defined(_X86_) \
+ || defined(__THW_INTEL__) || defined(__I86__) || defined(__INTEL__) || defined(__386) \
+ || defined(_I386) || defined(sun386) /* x86 */
+    #define GD_ARCH_X86
+    #define GD_ARCH_NAME "x86"
+    #if defined(__i686__) || _M_IX86 == 600 || __I86__ == 6
+        #define GD_ARCH_I686
+        #define GD_ARCH_VERSION 6
+        #define GD_ARCH_VERSION_NAME "i686"
+        #define GD_BITS 32
+    #elif defined(__i585__) || _M_IX86 == 500 || __I86__ == 5
+        #define GD_ARCH_I586
+        #define GD_ARCH_VERSION 5
+        #define GD_ARCH_VERSION_NAME "i586"
+        #define GD_BITS 32
+    #elif defined(__i486__) || _M_IX86 == 400 || __I86__ == 4
+        #define GD_ARCH_I486
+        #define GD_ARCH_VERSION 4
+        #define GD_ARCH_VERSION_NAME "i486"
+        #define GD_BITS 32
+    #elif defined(__i386__) || _M_IX86 == 300 || __I86__ == 3
+        #define GD_ARCH_I386
+        #define GD_ARCH_VERSION 3
+        #define GD_ARCH_VERSION_NAME "i386"
+        #define GD_BITS 32
+    #elif defined(__386__) || defined(_M_I386)
+        #define GD_BITS 32
+    #elif defined(_M_I86)
+        #define GD_BITS 16
+    #else
+        #if !GD_NO_CUSTOM_WARNINGS
+            #warning "Failed to identify x86 bit count, assuming 32..."
+        #endif
+        #define GD_BITS 32
+    #endif
+#endif
+
+#if defined(__amd64__) || defined(__amd64) || defined(__x86_64__) || defined(__x86_64) \
+ || defined(_M_X64) || defined(_M_AMD64) /* x86_64 */
+    #define GD_ARCH_X86_64
+    #define GD_ARCH_NAME "x86_64"
+    #define GD_BITS 64
+#endif
+
+#ifndef GD_ARCH_NAME
+    #if !GD_NO_CUSTOM_WARNINGS
+        #warning "Unknown architecture"
+    #endif
+    #define GD_ARCH_NAME "Unknown"
+#endif
+
+#ifndef GD_ARCH_VERSION
+    #define GD_ARCH_VERSION 1
+    #define GD_ARCH_VERSION_NAME ""
+#endif
+
+#if !defined(GD_BITS) && (defined(__LP64__) || defined(_LP64))
+    #define GD_BITS 64
+#endif
+
+#if !defined(GD_BITS) && defined(__SIZEOF_POINTER__)
+    #define GD_BITS (__SIZEOF_POINTER__ * 8)
+#endif
+
+#ifndef GD_BITS
+    #define GD_BITS -1
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * GenericDetect - Atomic and lock-free capabilities (GD_ATOMIC_LOCK_FREE_*, GD_HAS_DWCAS, ...)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_ATOMICS_H_
+#define GENERIC_DETECT_ATOMICS_H_
+
+#include "Compiler.h"
+#include "Arch.h"
+#include "Hints.h"
+
+/* Atomics */
+
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+    #define GD_HAS_C11_ATOMICS 1
+#else
+    #define GD_HAS_C11_ATOMICS 0
+#endif
+
+#if defined(__cplusplus) && (__cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L))
+    #define GD_HAS_STD_ATOMIC 1
+#else
+    #define GD_HAS_STD_ATOMIC 0
+#endif
+
+/* NOTE: GCC and Clang define __GCC_HAVE_SYNC_COMPARE_AND_SWAP_N for every width the target can do inline */
+#if GD_INTERNAL_GNUC && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_1
+        #define GD_ATOMIC_LOCK_FREE_8 1
+    #endif
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_2
+        #define GD_ATOMIC_LOCK_FREE_16 1
+    #endif
+    #define GD_ATOMIC_LOCK_FREE_32 1
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+        #define GD_ATOMIC_LOCK_FREE_64 1
+    #endif
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+        #define GD_ATOMIC_LOCK_FREE_128 1
+    #endif
+#elif defined(GD_COMPILER_MSVC)
+    /* NOTE: 64 bit Windows requires cmpxchg16b, so _InterlockedCompareExchange128 is always there */
+    #define GD_ATOMIC_LOCK_FREE_8 1
+    #define GD_ATOMIC_LOCK_FREE_16 1
+    #define GD_ATOMIC_LOCK_FREE_32 1
+    #define GD_ATOMIC_LOCK_FREE_64 1
+    #if defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+        #define GD_ATOMIC_LOCK_FREE_128 1
+    #endif
+#elif defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+    #define GD_ATOMIC_LOCK_FREE_8 1
+    #define GD_ATOMIC_LOCK_FREE_16 1
+    #define GD_ATOMIC_LOCK_FREE_32 1
+    #define GD_ATOMIC_LOCK_FREE_64 1
+#endif
+
+#ifndef GD_ATOMIC_LOCK_FREE_8
+    #define GD_ATOMIC_LOCK_FREE_8 0
+#endif
+#ifndef GD_ATOMIC_LOCK_FREE_16
+    #define GD_ATOMIC_LOCK_FREE_16 0
+#endif
+#ifndef GD_ATOMIC_LOCK_FREE_32
+    #define GD_ATOMIC_LOCK_FREE_32 0
+#endif
+#ifndef GD_ATOMIC_LOCK_FREE_64
+    #define GD_ATOMIC_LOCK_FREE_64 0
+#endif
+#ifndef GD_ATOMIC_LOCK_FREE_128
+    #define GD_ATOMIC_LOCK_FREE_128 0
+#endif
+
+/* Compare and swap of two pointers at once (cmpxchg8b, cmpxchg16b, ldxp / stxp or casp) */
+#if (defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ == 4) || (!defined(__SIZEOF_POINTER__) && defined(GD_BITS) && GD_BITS == 32)
+    #define GD_HAS_DWCAS GD_ATOMIC_LOCK_FREE_64
+#else
+    #define GD_HAS_DWCAS GD_ATOMIC_LOCK_FREE_128
+#endif
+
+/* ARMv8.1 Large System Extensions, single instruction atomics instead of ldxr / stxr loops */
+#if defined(__ARM_FEATURE_ATOMICS)
+    #define GD_HAS_LSE 1
+#else
+    #define GD_HAS_LSE 0
+#endif
+
+/* 1 if plain loads and stores are ordered like total store order, only store -> load can be reordered */
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_SPARC) || defined(__s390__) \
+ || defined(__riscv_ztso)
+    #define GD_MEMORY_MODEL_TSO 1
+#else
+    #define GD_MEMORY_MODEL_TSO 0
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * GenericDetect - Library options, versioning and 64 bit integer types
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_BASE_H_
+#define GENERIC_DETECT_BASE_H_
+
+/* Options */
+
+/* Do not detect android as linux */
+#ifndef GD_ANDROID_IS_NOT_LINUX
+    #define GD_ANDROID_IS_NOT_LINUX 0
+#endif
+
+/* Do not use #warning */
+#ifndef GD_NO_CUSTOM_WARNINGS
+    #define GD_NO_CUSTOM_WARNINGS 0
+#endif
+
+/* Do not use #include */
+#ifndef GD_NO_EXTERNAL_INCLUDES
+    #define GD_NO_EXTERNAL_INCLUDES 0
+
+    /* Disallow detecting the LibC without external includes */
+    #ifdef GD_NO_LIBC_DETECTION
+        #if GD_NO_LIBC_DETECTION
+            #if !GD_NOT_CUSTOM_WARNINGS
+                #warning "Detect the LibC is not allowed without external includes"
+            #endif
+        #endif
+        #undef GD_NO_LIBC_DETECTION
+    #endif
+    #define GD_NO_LIBC_DETECTION 0
+#endif
+
+/* Do not detect the LibC */
+#ifndef GD_NO_LIBC_DETECTION
+    #define GD_NO_LIBC_DETECTION 0
+#endif
+
+/* Versioning */
+#define GD_MAKE_VERSION(major,minor,patch) (((major) << 24) + ((minor) << 16) + (patch))
+#define GD_VERSION_MAJOR(version) (version >> 24)
+#define GD_VERSION_MINOR(version) ((version >> 16) & 0xFF)
+#define GD_VERSION_PATCH(version) (version & 0xFFFF)
+
+/* Types */
+
+/*
+ * NOTE: long long is C99 and C++11, GCC and Clang accept it before as an extension, which -pedantic only allows when
+ *       marked. __extension__ does not silence it for a typedef in C++, so the warning is turned off around it there.
+ */
+#if defined(__GNUC__) && !defined(__cplusplus) && !(defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+    __extension__ typedef unsigned long long gd_u64_t;
+    __extension__ typedef long long gd_i64_t;
+#elif (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)))) \
+   && defined(__cplusplus) && __cplusplus < 201103L
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wlong-long"
+    typedef unsigned long long gd_u64_t;
+    typedef long long gd_i64_t;
+    #pragma GCC diagnostic pop
+#else
+    typedef unsigned long long gd_u64_t;
+    typedef long long gd_i64_t;
+#endif
+
+#endif
@@ -0,0 +1,337 @@
+/*
+ * GenericDetect - Bit manipulation (GD_HAS_FAST_*, gd_popcount*, gd_clz*, ...)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_BITS_H_
+#define GENERIC_DETECT_BITS_H_
+
+#include "Compiler.h"
+#include "Arch.h"
+#include "SIMD.h"
+#include "Hints.h"
+
+/* Bit manipulation */
+
+/* 1 if the operation compiles to a single instruction (or two, like rbit + clz for ctz on ARM) */
+#if defined(GD_SIMD_POPCNT) || defined(GD_ARCH_AARCH64) || (defined(GD_ARCH_ARM) && defined(GD_SIMD_NEON)) \
+ || defined(_ARCH_PWR7) || defined(__riscv_zbb) || defined(__alpha_cix__)
+    #define GD_HAS_FAST_POPCOUNT 1
+#else
+    #define GD_HAS_FAST_POPCOUNT 0
+#endif
+
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64) || defined(GD_ARCH_POWERPC) \
+ || defined(GD_ARCH_LOONGARCH) || (defined(GD_ARCH_ARM) && defined(__ARM_FEATURE_CLZ)) || defined(__riscv_zbb) \
+ || (defined(GD_ARCH_MIPS) && defined(__mips_isa_rev)) || defined(__alpha_cix__)
+    #define GD_HAS_FAST_CLZ 1
+#else
+    #define GD_HAS_FAST_CLZ 0
+#endif
+
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64) || defined(GD_ARCH_LOONGARCH) \
+ || (defined(GD_ARCH_ARM) && defined(__ARM_FEATURE_CLZ) && defined(__ARM_ARCH) && __ARM_ARCH >= 7) \
+ || defined(_ARCH_PWR9) || defined(__riscv_zbb) || defined(__alpha_cix__)
+    #define GD_HAS_FAST_CTZ 1
+#else
+    #define GD_HAS_FAST_CTZ 0
+#endif
+
+#if defined(GD_SIMD_BMI2) && defined(GD_ARCH_X86_64)
+    #define GD_HAS_FAST_PDEP 1
+#else
+    #define GD_HAS_FAST_PDEP 0
+#endif
+
+#if GD_HAS_BUILTIN(__builtin_add_overflow) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(5, 0, 0)
+    #define GD_INTERNAL_OVERFLOW_BUILTINS 1
+#else
+    #define GD_INTERNAL_OVERFLOW_BUILTINS 0
+#endif
+
+/* NOTE: The intrinsics are declared instead of including <intrin.h>, which every file would have to preprocess */
+#if defined(GD_COMPILER_MSVC) && !GD_NO_EXTERNAL_INCLUDES
+    #include <stdlib.h>
+    #define GD_INTERNAL_MSVC_INTRINSICS 1
+    GD_INTERNAL_EXTERN_C unsigned char _BitScanForward(unsigned long* index, unsigned long mask);
+    GD_INTERNAL_EXTERN_C unsigned char _BitScanReverse(unsigned long* index, unsigned long mask);
+    #pragma intrinsic(_BitScanForward, _BitScanReverse)
+    #if defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+        GD_INTERNAL_EXTERN_C unsigned char _BitScanForward64(unsigned long* index, unsigned __int64 mask);
+        GD_INTERNAL_EXTERN_C unsigned char _BitScanReverse64(unsigned long* index, unsigned __int64 mask);
+        #pragma intrinsic(_BitScanForward64, _BitScanReverse64)
+    #endif
+    #if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+        GD_INTERNAL_EXTERN_C unsigned int __popcnt(unsigned int value);
+        GD_INTERNAL_EXTERN_C unsigned int __lzcnt(unsigned int value);
+        #pragma intrinsic(__popcnt, __lzcnt)
+    #endif
+    #if defined(GD_ARCH_X86_64)
+        GD_INTERNAL_EXTERN_C unsigned __int64 __popcnt64(unsigned __int64 value);
+        GD_INTERNAL_EXTERN_C unsigned __int64 __lzcnt64(unsigned __int64 value);
+        GD_INTERNAL_EXTERN_C unsigned __int64 _umul128(unsigned __int64 a, unsigned __int64 b, unsigned __int64* high);
+        GD_INTERNAL_EXTERN_C unsigned __int64 _pdep_u64(unsigned __int64 x, unsigned __int64 mask);
+        GD_INTERNAL_EXTERN_C unsigned __int64 _pext_u64(unsigned __int64 x, unsigned __int64 mask);
+        #pragma intrinsic(__popcnt64, __lzcnt64, _umul128)
+    #endif
+    #if defined(GD_ARCH_AARCH64)
+        GD_INTERNAL_EXTERN_C unsigned int _CountOneBits(unsigned long value);
+        GD_INTERNAL_EXTERN_C unsigned int _CountOneBits64(unsigned __int64 value);
+        GD_INTERNAL_EXTERN_C unsigned int _CountLeadingZeros(unsigned long value);
+        GD_INTERNAL_EXTERN_C unsigned int _CountLeadingZeros64(unsigned __int64 value);
+    #endif
+#else
+    #define GD_INTERNAL_MSVC_INTRINSICS 0
+#endif
+
+GD_INLINE int gd_popcount32(unsigned int x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_POPCOUNT
+    return __builtin_popcount(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && GD_HAS_FAST_POPCOUNT && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    return (int)__popcnt(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_AARCH64)
+    return (int)_CountOneBits(x);
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return (int)((x * 0x01010101u) >> 24);
+#endif
+}
+
+GD_INLINE int gd_popcount64(gd_u64_t x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_POPCOUNT
+    return __builtin_popcountll(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && GD_HAS_FAST_POPCOUNT && defined(GD_ARCH_X86_64)
+    return (int)__popcnt64(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_AARCH64)
+    return (int)_CountOneBits64(x);
+#else
+    return gd_popcount32((unsigned int)x) + gd_popcount32((unsigned int)(x >> 32));
+#endif
+}
+
+/* Counts the leading zero bits, 32 / 64 for 0 */
+GD_INLINE int gd_clz32(unsigned int x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_CLZ
+    return x ? __builtin_clz(x) : 32;
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_AARCH64)
+    return (int)_CountLeadingZeros(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_SIMD_LZCNT)
+    return (int)__lzcnt(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    unsigned long index;
+    return _BitScanReverse(&index, x) ? 31 - (int)index : 32;
+#else
+    int count = 0;
+    if (x == 0)
+        return 32;
+    if (!(x & 0xFFFF0000u)) { count += 16; x <<= 16; }
+    if (!(x & 0xFF000000u)) { count += 8; x <<= 8; }
+    if (!(x & 0xF0000000u)) { count += 4; x <<= 4; }
+    if (!(x & 0xC0000000u)) { count += 2; x <<= 2; }
+    if (!(x & 0x80000000u)) { count += 1; }
+    return count;
+#endif
+}
+
+GD_INLINE int gd_clz64(gd_u64_t x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_CLZ
+    return x ? __builtin_clzll(x) : 64;
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_AARCH64)
+    return (int)_CountLeadingZeros64(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_SIMD_LZCNT) && defined(GD_ARCH_X86_64)
+    return (int)__lzcnt64(x);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_X86_64)
+    unsigned long index;
+    return _BitScanReverse64(&index, x) ? 63 - (int)index : 64;
+#else
+    return (x >> 32) ? gd_clz32((unsigned int)(x >> 32)) : 32 + gd_clz32((unsigned int)x);
+#endif
+}
+
+/* Counts the trailing zero bits, 32 / 64 for 0 */
+GD_INLINE int gd_ctz32(unsigned int x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_CTZ
+    return x ? __builtin_ctz(x) : 32;
+#elif GD_INTERNAL_MSVC_INTRINSICS && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64))
+    unsigned long index;
+    return _BitScanForward(&index, x) ? (int)index : 32;
+#else
+    return x ? gd_popcount32((x & (~x + 1)) - 1) : 32;
+#endif
+}
+
+GD_INLINE int gd_ctz64(gd_u64_t x)
+{
+#if GD_INTERNAL_GNUC && GD_HAS_FAST_CTZ
+    return x ? __builtin_ctzll(x) : 64;
+#elif GD_INTERNAL_MSVC_INTRINSICS && (defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64))
+    unsigned long index;
+    return _BitScanForward64(&index, x) ? (int)index : 64;
+#else
+    return (unsigned int)x ? gd_ctz32((unsigned int)x) : 32 + gd_ctz32((unsigned int)(x >> 32));
+#endif
+}
+
+/* NOTE: The compilers recognize this pattern as a single rotate instruction */
+GD_INLINE unsigned int gd_rotl32(unsigned int x, unsigned int n)
+{
+#if GD_INTERNAL_MSVC_INTRINSICS
+    return _rotl(x, (int)n);
+#else
+    return (x << (n & 31)) | (x >> ((0u - n) & 31));
+#endif
+}
+
+GD_INLINE unsigned int gd_rotr32(unsigned int x, unsigned int n)
+{
+#if GD_INTERNAL_MSVC_INTRINSICS
+    return _rotr(x, (int)n);
+#else
+    return (x >> (n & 31)) | (x << ((0u - n) & 31));
+#endif
+}
+
+GD_INLINE gd_u64_t gd_rotl64(gd_u64_t x, unsigned int n)
+{
+#if GD_INTERNAL_MSVC_INTRINSICS
+    return _rotl64(x, (int)n);
+#else
+    return (x << (n & 63)) | (x >> ((0u - n) & 63));
+#endif
+}
+
+GD_INLINE gd_u64_t gd_rotr64(gd_u64_t x, unsigned int n)
+{
+#if GD_INTERNAL_MSVC_INTRINSICS
+    return _rotr64(x, (int)n);
+#else
+    return (x >> (n & 63)) | (x << ((0u - n) & 63));
+#endif
+}
+
+/* Deposits the low bits of x into the set bits of mask (BMI2 pdep) */
+GD_INLINE gd_u64_t gd_pdep64(gd_u64_t x, gd_u64_t mask)
+{
+#if GD_HAS_FAST_PDEP && GD_INTERNAL_GNUC
+    return __builtin_ia32_pdep_di(x, mask);
+#elif GD_HAS_FAST_PDEP && GD_INTERNAL_MSVC_INTRINSICS
+    return _pdep_u64(x, mask);
+#else
+    gd_u64_t result = 0, bit;
+    for (bit = 1; mask; bit <<= 1)
+    {
+        if (x & bit)
+            result |= mask & (~mask + 1);
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
+
+/* Gathers the bits of x selected by mask into the low bits (BMI2 pext) */
+GD_INLINE gd_u64_t gd_pext64(gd_u64_t x, gd_u64_t mask)
+{
+#if GD_HAS_FAST_PDEP && GD_INTERNAL_GNUC
+    return __builtin_ia32_pext_di(x, mask);
+#elif GD_HAS_FAST_PDEP && GD_INTERNAL_MSVC_INTRINSICS
+    return _pext_u64(x, mask);
+#else
+    gd_u64_t result = 0, bit;
+    for (bit = 1; mask; bit <<= 1)
+    {
+        if (x & mask & (~mask + 1))
+            result |= bit;
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
+
+/* Stores the wrapped result and returns 1 if the operation overflowed */
+GD_INLINE int gd_add_overflow_u32(unsigned int a, unsigned int b, unsigned int* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_add_overflow(a, b, result);
+#else
+    *result = a + b;
+    return *result < a;
+#endif
+}
+
+GD_INLINE int gd_add_overflow_u64(gd_u64_t a, gd_u64_t b, gd_u64_t* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_add_overflow(a, b, result);
+#else
+    *result = a + b;
+    return *result < a;
+#endif
+}
+
+GD_INLINE int gd_add_overflow_i32(int a, int b, int* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_add_overflow(a, b, result);
+#else
+    unsigned int sum = (unsigned int)a + (unsigned int)b;
+    *result = (int)sum;
+    return (int)((((unsigned int)a ^ sum) & ((unsigned int)b ^ sum)) >> 31);
+#endif
+}
+
+GD_INLINE int gd_add_overflow_i64(gd_i64_t a, gd_i64_t b, gd_i64_t* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_add_overflow(a, b, result);
+#else
+    gd_u64_t sum = (gd_u64_t)a + (gd_u64_t)b;
+    *result = (gd_i64_t)sum;
+    return (int)((((gd_u64_t)a ^ sum) & ((gd_u64_t)b ^ sum)) >> 63);
+#endif
+}
+
+GD_INLINE int gd_sub_overflow_u64(gd_u64_t a, gd_u64_t b, gd_u64_t* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_sub_overflow(a, b, result);
+#else
+    *result = a - b;
+    return a < b;
+#endif
+}
+
+GD_INLINE int gd_mul_overflow_u32(unsigned int a, unsigned int b, unsigned int* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_mul_overflow(a, b, result);
+#else
+    gd_u64_t product = (gd_u64_t)a * b;
+    *result = (unsigned int)product;
+    return (product >> 32) != 0;
+#endif
+}
+
+GD_INLINE int gd_mul_overflow_u64(gd_u64_t a, gd_u64_t b, gd_u64_t* result)
+{
+#if GD_INTERNAL_OVERFLOW_BUILTINS
+    return __builtin_mul_overflow(a, b, result);
+#elif GD_INTERNAL_MSVC_INTRINSICS && defined(GD_ARCH_X86_64)
+    gd_u64_t high;
+    *result = _umul128(a, b, &high);
+    return high != 0;
+#else
+    *result = a * b;
+    return a != 0 && *result / a != b;
+#endif
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * GenericDetect - Build configuration detection (GD_BUILD_*, GD_FAST_MATH, GD_SANITIZER_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_BUILD_H_
+#define GENERIC_DETECT_BUILD_H_
+
+#include "Compiler.h"
+
+/* Build configuration */
+
+#ifdef __has_feature
+    #define GD_INTERNAL_HAS_FEATURE(feature) __has_feature(feature)
+#else
+    #define GD_INTERNAL_HAS_FEATURE(feature) 0
+#endif
+
+/* NOTE: MSVC has no macro for /O1 or /O2, the debug runtime (_DEBUG) is used as the closest sign of /Od */
+#ifndef GD_BUILD_OPTIMIZED
+    #if defined(__OPTIMIZE__) || (defined(GD_COMPILER_MSVC) && !defined(_DEBUG))
+        #define GD_BUILD_OPTIMIZED 1
+    #else
+        #define GD_BUILD_OPTIMIZED 0
+    #endif
+#endif
+
+#ifndef GD_BUILD_OPTIMIZED_SIZE
+    #if defined(__OPTIMIZE_SIZE__)
+        #define GD_BUILD_OPTIMIZED_SIZE 1
+    #else
+        #define GD_BUILD_OPTIMIZED_SIZE 0
+    #endif
+#endif
+
+/* Assertions are enabled or the debug runtime is used */
+#ifndef GD_BUILD_DEBUG
+    #if !defined(NDEBUG) || defined(_DEBUG)
+        #define GD_BUILD_DEBUG 1
+    #else
+        #define GD_BUILD_DEBUG 0
+    #endif
+#endif
+
+/* NOTE: GCC, Clang and MSVC do not tell the preprocessor about -flto or /GL, so the build system has to define this */
+#ifndef GD_BUILD_LTO
+    #define GD_BUILD_LTO 0
+#endif
+
+/* Instrumented for collecting a profile, and built with one */
+#ifndef GD_BUILD_PGO_GENERATE
+    #if defined(__LLVM_INSTR_PROFILE_GENERATE)
+        #define GD_BUILD_PGO_GENERATE 1
+    #else
+        #define GD_BUILD_PGO_GENERATE 0
+    #endif
+#endif
+
+#ifndef GD_BUILD_PGO_USE
+    #if defined(__LLVM_INSTR_PROFILE_USE)
+        #define GD_BUILD_PGO_USE 1
+    #else
+        #define GD_BUILD_PGO_USE 0
+    #endif
+#endif
+
+#ifndef GD_FAST_MATH
+    #if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+        #define GD_FAST_MATH 1
+    #else
+        #define GD_FAST_MATH 0
+    #endif
+#endif
+
+#ifndef GD_SANITIZER_ADDRESS
+    #if defined(__SANITIZE_ADDRESS__) || GD_INTERNAL_HAS_FEATURE(address_sanitizer)
+        #define GD_SANITIZER_ADDRESS 1
+    #else
+        #define GD_SANITIZER_ADDRESS 0
+    #endif
+#endif
+
+#ifndef GD_SANITIZER_THREAD
+    #if defined(__SANITIZE_THREAD__) || GD_INTERNAL_HAS_FEATURE(thread_sanitizer)
+        #define GD_SANITIZER_THREAD 1
+    #else
+        #define GD_SANITIZER_THREAD 0
+    #endif
+#endif
+
+#ifndef GD_SANITIZER_MEMORY
+    #if GD_INTERNAL_HAS_FEATURE(memory_sanitizer)
+        #define GD_SANITIZER_MEMORY 1
+    #else
+        #define GD_SANITIZER_MEMORY 0
+    #endif
+#endif
+
+/* NOTE: Only newer Clang versions report -fsanitize=undefined, with GCC the build system has to define this */
+#ifndef GD_SANITIZER_UNDEFINED
+    #if GD_INTERNAL_HAS_FEATURE(undefined_behavior_sanitizer)
+        #define GD_SANITIZER_UNDEFINED 1
+    #else
+        #define GD_SANITIZER_UNDEFINED 0
+    #endif
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * GenericDetect - Compiler detection (GD_COMPILER_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_COMPILER_H_
+#define GENERIC_DETECT_COMPILER_H_
+
+#include "Base.h"
+
+/* Compiler detection */
+
+#define GD_IS_COMPILER(compiler) (defined(GD_COMPILER_##compiler))
+
+#ifdef __clang__ /* Clang */
+    #define GD_COMPILER_CLANG
+    #define GD_COMPILER_NAME "Clang"
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__clang_major__, __clang_minor__, __clang_patchlevel__)
+#endif
+
+#if defined(__MWERKS__) || defined(__CWCC__) /* CodeWarrior */
+    #define GD_COMPILER_CODEWARRIOR
+    #define GD_COMPILER_NAME "CodeWarrior"
+    #if __MWERKS__ == 1
+        #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
+    #else
+        #define GD_COMPILER_VERSION GD_MAKE_VERSION(__MWERKS__ >> 24, (__MWERKS__ >> 16) & 8, __MWERKS__ & 16)
+    #endif
+#endif
+
+#ifdef __DMC__ /* Digital Mars */
+    #define GD_COMPILER_DIGITALMARS
+    #define GD_COMPILER_NAME "Digital Mars"
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__DMC__ >> 16, (__DMC__ >> 8) & 8, __DMC__ & 8)
+#endif
+
+#ifdef __ghs__ /* Green Hill C/C++ */
+    #define GD_COMPILER_GREEN_HILL
+    #define GD_COMPILER_NAME "Green Hill C/C++"
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GHS_VERSION_NUMBER__ / 100, (__GHS_VERSION_NUMBER__ / 10) % 10, __GHS_VERSION_NUMBER__ % 10)
+#endif
+
+#if defined(__INTEL_COMPILER) || defined(__ICC) || defined(__ECC) || defined(__ICL) /* ICC */
+    #define GD_COMPILER_ICC
+    #define GC_COMPILER_NAME "ICC"
+    #define GD_COMPILER_VERSION (__INTEL_COMPILER < 2000 ? GD_MAKE_VERSION(__INTEL_COMPILER / 100, __INTEL_COMPILER % 100, __INTEL_COMPILER_UPDATE) : GD_MAKE_VERSION(__INTEL_COMPILER, __INTEL_COMPILER_UPDATE, 0))
+#endif
+
+/* NOTE: This is not in order for a reason, because Clang and ICC also define __GNUC__ */
+#ifdef __GNUC__ /* GCC */
+    #ifndef GD_COMPILER_NAME
+        #define GD_COMPILER_GCC
+        #define GD_COMPILER_NAME "GCC"
+        #ifndef __GNUC_MINOR__
+            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, 0, 0)
+        #elif !defined(__GNUC_PATCHLEVEL__)
+            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, __GNUC_MINOR__, 0)
+        #else
+            #define GD_COMPILER_VERSION GD_MAKE_VERSION(__GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__)
+        #endif
+    #endif
+#endif
+
+#ifdef _MSC_VER /* MSVC / Visual Studio */
+    #ifndef GD_COMPILER_NAME
+        #define GD_COMPILER_MSVC
+        #define GD_COMPILER_NAME "MSVC"
+        #ifdef _MSC_FULL_VER
+            #define GD_COMPILER_VERSION (_MSC_FULL_VER < 100000000 ? GD_MAKE_VERSION(_MSC_FULL_VER / 1000000, (_MSC_FULL_VER % 1000000) / 10000, _MSC_FULL_VER % 10000) : GD_MAKE_VERSION(_MSC_FULL_VER / 10000000, (_MSC_FULL_VER % 10000000) / 10000, _MSC_FULL_VER % 100000))
+        #else
+            #define GD_COMPILER_VERSION GD_MAKE_VERSION(_MSC_VER / 100, _MSC_VER % 100, 0)
+        #endif
+    #endif
+#endif
+
+#if defined(__SDCC) || defined(SDCC) /* SDCC */
+    #define GD_COMPILER_SDCC
+    #define GD_COMPILER_NAME "SDCC"
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(__SDCC_VERSION_MAJOR, __SDCC_VERSION_MINOR, __SDCC_VERSION_PATCH)
+#endif
+
+#ifndef GD_COMPILER_NAME
+    #if !GD_NO_CUSTOM_WARNINGS
+        #warning "Unknown compiler"
+    #endif
+    #define GD_COMPILER_NAME "Unknown"
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
+#endif
+
+#ifndef GD_COMPILER_VERSION
+    #define GD_COMPILER_VERSION GD_MAKE_VERSION(1, 0, 0)
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ * GenericDetect - Endianness detection and byte order helpers (GD_ENDIAN_*, GD_BSWAP*, gd_load_* / gd_store_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_ENDIAN_H_
+#define GENERIC_DETECT_ENDIAN_H_
+
+#include "Compiler.h"
+#include "OS.h"
+#include "Arch.h"
+#include "Hints.h"
+
+/* Endianness detection */
+
+#define GD_IS_ENDIAN(endian) (defined(GD_ENDIAN_##endian))
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define GD_ENDIAN_LITTLE
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define GD_ENDIAN_BIG
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_PDP_ENDIAN__) && __BYTE_ORDER__ == __ORDER_PDP_ENDIAN__
+    #define GD_ENDIAN_PDP
+#elif defined(__BIG_ENDIAN__) || defined(__ARMEB__) || defined(__AARCH64EB__) || defined(__THUMBEB__) \
+   || defined(_MIPSEB) || defined(__MIPSEB) || defined(__MIPSEB__)
+    #define GD_ENDIAN_BIG
+#elif defined(__LITTLE_ENDIAN__) || defined(__ARMEL__) || defined(__AARCH64EL__) || defined(__THUMBEL__) \
+   || defined(_MIPSEL) || defined(__MIPSEL) || defined(__MIPSEL__)
+    #define GD_ENDIAN_LITTLE
+/* NOTE: Windows and MSVC only target little endian machines */
+#elif defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_ALPHA) || defined(GD_ARCH_LOONGARCH) \
+   || defined(GD_ARCH_RISCV) || defined(GD_OS_WINDOWS) || defined(GD_COMPILER_MSVC) \
+   || (defined(GD_ARCH_ITANIUM) && !defined(GD_OS_HPUX))
+    #define GD_ENDIAN_LITTLE
+#elif defined(GD_ARCH_SPARC) || defined(GD_ARCH_M68K) || defined(GD_ARCH_HPPA) || defined(GD_ARCH_POWERPC) \
+   || defined(GD_ARCH_CONVEX) || defined(GD_ARCH_ITANIUM)
+    #define GD_ENDIAN_BIG
+#endif
+
+#if defined(GD_ENDIAN_LITTLE)
+    #define GD_ENDIAN_NAME "Little"
+#elif defined(GD_ENDIAN_BIG)
+    #define GD_ENDIAN_NAME "Big"
+#elif defined(GD_ENDIAN_PDP)
+    #define GD_ENDIAN_NAME "PDP"
+#else
+    #if !GD_NO_CUSTOM_WARNINGS
+        #warning "Unknown endianness"
+    #endif
+    #define GD_ENDIAN_NAME "Unknown"
+#endif
+
+/* Unaligned loads and stores are handled by the hardware at (nearly) full speed */
+#ifndef GD_UNALIGNED_ACCESS_FAST
+    #if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) || defined(GD_ARCH_POWERPC64) || defined(GD_ARCH_LOONGARCH)
+        #define GD_UNALIGNED_ACCESS_FAST 1
+    #elif defined(GD_ARCH_AARCH64) && (defined(__ARM_FEATURE_UNALIGNED) || defined(GD_COMPILER_MSVC))
+        #define GD_UNALIGNED_ACCESS_FAST 1
+    #elif defined(GD_ARCH_ARM) && defined(__ARM_FEATURE_UNALIGNED)
+        #define GD_UNALIGNED_ACCESS_FAST 1
+    #elif defined(GD_ARCH_RISCV) && defined(__riscv_misaligned_fast)
+        #define GD_UNALIGNED_ACCESS_FAST 1
+    #else
+        #define GD_UNALIGNED_ACCESS_FAST 0
+    #endif
+#endif
+
+/* Byte order helpers */
+
+#if defined(GD_COMPILER_GCC) || defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC)
+    #define GD_INTERNAL_MEMCPY(destination, source, size) __builtin_memcpy((destination), (source), (size))
+#elif !GD_NO_EXTERNAL_INCLUDES
+    #include <string.h>
+    #define GD_INTERNAL_MEMCPY(destination, source, size) memcpy((destination), (source), (size))
+#endif
+
+#if GD_HAS_BUILTIN(__builtin_bswap16) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 8, 0)
+    #define GD_BSWAP16(x) ((unsigned short)__builtin_bswap16((unsigned short)(x)))
+#endif
+#if GD_HAS_BUILTIN(__builtin_bswap32) || defined(GD_COMPILER_ICC) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 3, 0)
+    #define GD_BSWAP32(x) ((unsigned int)__builtin_bswap32((unsigned int)(x)))
+    #define GD_BSWAP64(x) ((gd_u64_t)__builtin_bswap64((gd_u64_t)(x)))
+#elif defined(GD_COMPILER_MSVC) && !GD_NO_EXTERNAL_INCLUDES
+    #include <stdlib.h>
+    #define GD_BSWAP16(x) ((unsigned short)_byteswap_ushort((unsigned short)(x)))
+    #define GD_BSWAP32(x) ((unsigned int)_byteswap_ulong((unsigned long)(x)))
+    #define GD_BSWAP64(x) ((gd_u64_t)_byteswap_uint64((gd_u64_t)(x)))
+#endif
+
+GD_INLINE unsigned short gd_bswap16(unsigned short x)
+{
+#ifdef GD_BSWAP16
+    return GD_BSWAP16(x);
+#else
+    return (unsigned short)((x >> 8) | (x << 8));
+#endif
+}
+
+GD_INLINE unsigned int gd_bswap32(unsigned int x)
+{
+#ifdef GD_BSWAP32
+    return GD_BSWAP32(x);
+#else
+    return (x >> 24) | ((x >> 8) & 0xFF00u) | ((x << 8) & 0xFF0000u) | (x << 24);
+#endif
+}
+
+GD_INLINE gd_u64_t gd_bswap64(gd_u64_t x)
+{
+#ifdef GD_BSWAP64
+    return GD_BSWAP64(x);
+#else
+    return ((gd_u64_t)gd_bswap32((unsigned int)x) << 32) | gd_bswap32((unsigned int)(x >> 32));
+#endif
+}
+
+#ifndef GD_BSWAP16
+    #define GD_BSWAP16(x) gd_bswap16(x)
+#endif
+#ifndef GD_BSWAP32
+    #define GD_BSWAP32(x) gd_bswap32(x)
+#endif
+#ifndef GD_BSWAP64
+    #define GD_BSWAP64(x) gd_bswap64(x)
+#endif
+
+/* NOTE: memcpy of a fixed size compiles to a single (unaligned) load or store where the target allows it */
+#if defined(GD_INTERNAL_MEMCPY) && (defined(GD_ENDIAN_LITTLE) || defined(GD_ENDIAN_BIG))
+    #define GD_INTERNAL_LOAD_STORE(bits, type, native, swapped) \
+        GD_INLINE type gd_load_##native##bits(const void* source) { type x; GD_INTERNAL_MEMCPY(&x, source, sizeof(x)); return x; } \
+        GD_INLINE type gd_load_##swapped##bits(const void* source) { type x; GD_INTERNAL_MEMCPY(&x, source, sizeof(x)); return GD_BSWAP##bits(x); } \
+        GD_INLINE void gd_store_##native##bits(void* destination, type x) { GD_INTERNAL_MEMCPY(destination, &x, sizeof(x)); } \
+        GD_INLINE void gd_store_##swapped##bits(void* destination, type x) { x = GD_BSWAP##bits(x); GD_INTERNAL_MEMCPY(destination, &x, sizeof(x)); }
+    #ifdef GD_ENDIAN_LITTLE
+        GD_INTERNAL_LOAD_STORE(16, unsigned short, le, be)
+        GD_INTERNAL_LOAD_STORE(32, unsigned int, le, be)
+        GD_INTERNAL_LOAD_STORE(64, gd_u64_t, le, be)
+    #else
+        GD_INTERNAL_LOAD_STORE(16, unsigned short, be, le)
+        GD_INTERNAL_LOAD_STORE(32, unsigned int, be, le)
+        GD_INTERNAL_LOAD_STORE(64, gd_u64_t, be, le)
+    #endif
+#else
+    #define GD_INTERNAL_LOAD_STORE(bits, type) \
+        GD_INLINE type gd_load_le##bits(const void* source) \
+        { \
+            const unsigned char* bytes = (const unsigned char*)source; \
+            type x = 0; \
+            int i; \
+            for (i = bits / 8 - 1; i >= 0; i--) \
+                x = (type)((x << 8) | bytes[i]); \
+            return x; \
+        } \
+        GD_INLINE type gd_load_be##bits(const void* source) \
+        { \
+            const unsigned char* bytes = (const unsigned char*)source; \
+            type x = 0; \
+            int i; \
+            for (i = 0; i < bits / 8; i++) \
+                x = (type)((x << 8) | bytes[i]); \
+            return x; \
+        } \
+        GD_INLINE void gd_store_le##bits(void* destination, type x) \
+        { \
+            unsigned char* bytes = (unsigned char*)destination; \
+            int i; \
+            for (i = 0; i < bits / 8; i++, x = (type)(x >> 8)) \
+                bytes[i] = (unsigned char)x; \
+        } \
+        GD_INLINE void gd_store_be##bits(void* destination, type x) \
+        { \
+            unsigned char* bytes = (unsigned char*)destination; \
+            int i; \
+            for (i = bits / 8 - 1; i >= 0; i--, x = (type)(x >> 8)) \
+                bytes[i] = (unsigned char)x; \
+        }
+    GD_INTERNAL_LOAD_STORE(16, unsigned short)
+    GD_INTERNAL_LOAD_STORE(32, unsigned int)
+    GD_INTERNAL_LOAD_STORE(64, gd_u64_t)
+#endif
+#undef GD_INTERNAL_LOAD_STORE
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * GenericDetect - Function attributes and optimization hints (GD_API, GD_INLINE, GD_LIKELY, ...)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_HINTS_H_
+#define GENERIC_DETECT_HINTS_H_
+
+#include "Compiler.h"
+
+/* Function attributes */
+
+/* The variables of the implementation take GD_API too, except for the default extern that does not belong on a definition */
+#ifndef GD_API
+    #define GD_API extern
+    #define GD_INTERNAL_API_DATA
+#else
+    #define GD_INTERNAL_API_DATA GD_API
+#endif
+
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+    #define GD_INLINE static inline
+#elif defined(GD_COMPILER_GCC) || defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC)
+    #define GD_INLINE static __inline__
+#elif defined(GD_COMPILER_MSVC)
+    #define GD_INLINE static __inline
+#else
+    #define GD_INLINE static
+#endif
+
+/* Optimization hints */
+
+#ifdef __has_attribute
+    #define GD_HAS_ATTRIBUTE(attribute) __has_attribute(attribute)
+#else
+    #define GD_HAS_ATTRIBUTE(attribute) 0
+#endif
+
+/* NOTE: GCC only has __has_builtin since GCC 10, so older versions are checked by version */
+#ifdef __has_builtin
+    #define GD_HAS_BUILTIN(builtin) __has_builtin(builtin)
+#else
+    #define GD_HAS_BUILTIN(builtin) 0
+#endif
+
+/* NOTE: ICC only understands the GNU syntax when it is pretending to be GCC */
+#if defined(GD_COMPILER_GCC) || defined(GD_COMPILER_CLANG) || (defined(GD_COMPILER_ICC) && defined(__GNUC__))
+    #define GD_INTERNAL_GNUC 1
+#else
+    #define GD_INTERNAL_GNUC 0
+#endif
+
+/* For declarations of compiler intrinsics, which are C functions */
+#ifdef __cplusplus
+    #define GD_INTERNAL_EXTERN_C extern "C"
+#else
+    #define GD_INTERNAL_EXTERN_C
+#endif
+
+/* 0 when using another compiler, so the version checks below stay simple */
+#ifdef GD_COMPILER_GCC
+    #define GD_INTERNAL_GCC_VERSION GD_COMPILER_VERSION
+#else
+    #define GD_INTERNAL_GCC_VERSION 0
+#endif
+#ifdef GD_COMPILER_MSVC
+    #define GD_INTERNAL_MSVC_VERSION _MSC_VER
+#else
+    #define GD_INTERNAL_MSVC_VERSION 0
+#endif
+
+#if GD_INTERNAL_GNUC
+    #define GD_LIKELY(x) __builtin_expect(!!(x), 1)
+    #define GD_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+    #define GD_LIKELY(x) (x)
+    #define GD_UNLIKELY(x) (x)
+#endif
+
+/* Used instead of GD_INLINE */
+#if GD_INTERNAL_GNUC && (!defined(GD_COMPILER_GCC) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(3, 1, 0))
+    #define GD_FORCE_INLINE GD_INLINE __attribute__((always_inline))
+#elif GD_INTERNAL_MSVC_VERSION >= 1200 || (defined(GD_COMPILER_ICC) && defined(_MSC_VER))
+    #define GD_FORCE_INLINE static __forceinline
+#else
+    #define GD_FORCE_INLINE GD_INLINE
+#endif
+
+#if GD_INTERNAL_GNUC && (!defined(GD_COMPILER_GCC) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(3, 1, 0))
+    #define GD_NOINLINE __attribute__((noinline))
+#elif GD_INTERNAL_MSVC_VERSION >= 1300 || (defined(GD_COMPILER_ICC) && defined(_MSC_VER))
+    #define GD_NOINLINE __declspec(noinline)
+#else
+    #define GD_NOINLINE
+#endif
+
+#if GD_INTERNAL_GNUC && (!defined(GD_COMPILER_GCC) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 1, 0))
+    #define GD_FLATTEN __attribute__((flatten))
+#else
+    #define GD_FLATTEN
+#endif
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L && !defined(__cplusplus)
+    #define GD_RESTRICT restrict
+#elif GD_INTERNAL_GNUC
+    #define GD_RESTRICT __restrict__
+#elif GD_INTERNAL_MSVC_VERSION >= 1400 || (defined(GD_COMPILER_ICC) && defined(_MSC_VER))
+    #define GD_RESTRICT __restrict
+#else
+    #define GD_RESTRICT
+#endif
+
+#if GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 3, 0) || (defined(GD_COMPILER_CLANG) && GD_HAS_ATTRIBUTE(hot))
+    #define GD_HOT __attribute__((hot))
+#else
+    #define GD_HOT
+#endif
+
+#if GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 3, 0) || (GD_INTERNAL_GNUC && GD_HAS_ATTRIBUTE(cold))
+    #define GD_COLD __attribute__((cold))
+#else
+    #define GD_COLD
+#endif
+
+#if GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 5, 0) || defined(GD_COMPILER_CLANG) || (defined(GD_COMPILER_ICC) && defined(__GNUC__))
+    #define GD_UNREACHABLE() __builtin_unreachable()
+#elif defined(GD_COMPILER_MSVC) || (defined(GD_COMPILER_ICC) && defined(_MSC_VER))
+    #define GD_UNREACHABLE() __assume(0)
+#else
+    #define GD_UNREACHABLE() ((void)0)
+#endif
+
+/* NOTE: Before GCC 13 the condition is evaluated, so it must not have side effects */
+#if defined(GD_COMPILER_CLANG)
+    #define GD_ASSUME(condition) __builtin_assume(condition)
+#elif GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(13, 0, 0)
+    #define GD_ASSUME(condition) __attribute__((assume(condition)))
+#elif defined(GD_COMPILER_MSVC) || (defined(GD_COMPILER_ICC) && defined(_MSC_VER))
+    #define GD_ASSUME(condition) __assume(condition)
+#elif GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 5, 0) || (defined(GD_COMPILER_ICC) && defined(__GNUC__))
+    #define GD_ASSUME(condition) do { if (!(condition)) __builtin_unreachable(); } while (0)
+#else
+    #define GD_ASSUME(condition) ((void)0)
+#endif
+
+/* rw: 0 - read, 1 - write, locality: 0 (no temporal locality) to 3 (keep in all cache levels) */
+#if GD_INTERNAL_GNUC && (!defined(GD_COMPILER_GCC) || GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(3, 1, 0))
+    #define GD_PREFETCH(address, rw, locality) __builtin_prefetch((address), (rw), (locality))
+#elif defined(GD_COMPILER_MSVC) && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    /* NOTE: Declared instead of including <intrin.h>, so the hints are spelled out: MSVC numbers them _MM_HINT_NTA 0,
+             _MM_HINT_T0 1, _MM_HINT_T1 2 and _MM_HINT_T2 3, which does not follow the locality */
+    GD_INTERNAL_EXTERN_C void _mm_prefetch(char const* address, int hint);
+    #define GD_PREFETCH(address, rw, locality) _mm_prefetch((const char*)(address), \
+        (locality) == 3 ? 1 : (locality) == 2 ? 2 : (locality) == 1 ? 3 : 0)
+#elif defined(GD_COMPILER_MSVC) && (defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64))
+    GD_INTERNAL_EXTERN_C void __prefetch(const void* address);
+    #pragma intrinsic(__prefetch)
+    #define GD_PREFETCH(address, rw, locality) __prefetch((const void*)(address))
+#else
+    #define GD_PREFETCH(address, rw, locality) ((void)(address))
+#endif
+
+/* Returns the pointer, which the compiler can then assume to be aligned */
+#if GD_INTERNAL_GCC_VERSION >= GD_MAKE_VERSION(4, 7, 0) || defined(GD_COMPILER_CLANG)
+    #define GD_ASSUME_ALIGNED(pointer, alignment) __builtin_assume_aligned((pointer), (alignment))
+#else
+    #define GD_ASSUME_ALIGNED(pointer, alignment) (pointer)
+#endif
+
+#endif
@@ -0,0 +1,3416 @@
+/*
+ * GenericDetect - Implementation of the runtime detection functions, compiled with GD_IMPLEMENTATION
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#if defined(GD_IMPLEMENTATION) && !defined(GENERIC_DETECT_IMPLEMENTATION_)
+#define GENERIC_DETECT_IMPLEMENTATION_
+
+#include "Runtime.h"
+
+#if defined(GD_OS_LINUX) && !GD_NO_EXTERNAL_INCLUDES && !(defined(GD_LIBC_GLIBC) && GD_LIBC_VERSION < GD_MAKE_VERSION(2, 16, 0))
+    #define GD_INTERNAL_HAS_GETAUXVAL 1
+#else
+    #define GD_INTERNAL_HAS_GETAUXVAL 0
+#endif
+
+#if defined(GD_OS_GENERIC_UNIX) && !GD_NO_EXTERNAL_INCLUDES
+    #define GD_INTERNAL_HAS_POSIX 1
+#else
+    #define GD_INTERNAL_HAS_POSIX 0
+#endif
+
+#if (defined(GD_OS_GENERIC_APPLE) || defined(GD_OS_FREEBSD) || defined(GD_OS_DRAGONFLY) || defined(GD_OS_NETBSD)) && !GD_NO_EXTERNAL_INCLUDES
+    #define GD_INTERNAL_HAS_SYSCTLBYNAME 1
+#else
+    #define GD_INTERNAL_HAS_SYSCTLBYNAME 0
+#endif
+
+#if !GD_NO_EXTERNAL_INCLUDES
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <time.h>
+    #if defined(GD_COMPILER_MSVC)
+        #include <intrin.h>
+    #endif
+    #if defined(GD_OS_WINDOWS)
+        #include <windows.h>
+    #endif
+    #if GD_INTERNAL_HAS_POSIX
+        #include <errno.h>
+        #include <fcntl.h>
+        #include <sched.h>
+        #include <unistd.h>
+        #include <sys/types.h>
+        #include <sys/stat.h>
+        #include <sys/mman.h>
+        #include <sys/utsname.h>
+    #endif
+    #if GD_INTERNAL_HAS_GETAUXVAL || (defined(GD_OS_FREEBSD) && defined(GD_ARCH_AARCH64))
+        #include <sys/auxv.h>
+    #endif
+    #if defined(GD_OS_LINUX)
+        #include <dirent.h>
+        #include <sys/socket.h>
+        #include <sys/syscall.h>
+    #endif
+    #if (defined(GD_OS_GENERIC_BSD) || defined(GD_OS_GENERIC_APPLE)) && GD_INTERNAL_HAS_POSIX
+        #include <sys/event.h>
+    #endif
+    #if defined(GD_OS_GENERIC_APPLE)
+        #include <dlfcn.h>
+    #endif
+    #if defined(GD_OS_FREEBSD)
+        #include <sys/param.h>
+        #include <sys/cpuset.h>
+    #endif
+    #if GD_INTERNAL_HAS_SYSCTLBYNAME
+        #include <sys/types.h>
+        #include <sys/time.h>
+        #include <sys/sysctl.h>
+    #endif
+#endif
+
+/* NOTE: glibc hides syscall() in strict standard modes, C++ compilers always enable it */
+#if defined(GD_LIBC_GLIBC) && defined(GD_OS_LINUX) && !GD_NO_EXTERNAL_INCLUDES && !defined(__USE_MISC) && !defined(__cplusplus)
+    long syscall(long number, ...);
+#endif
+
+#ifndef AT_HWCAP
+    #define AT_HWCAP 16
+#endif
+#ifndef AT_HWCAP2
+    #define AT_HWCAP2 26
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Internal helpers */
+
+/* A 64 bit constant from two 32 bit halves, long long literals are not C89 or C++98 */
+#define GD_INTERNAL_U64(high, low) (((gd_u64_t)(high) << 32) | (gd_u64_t)(low))
+
+#if defined(GD_COMPILER_GCC) || defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC)
+    #define GD_INTERNAL_HELPER static __attribute__((unused))
+#else
+    #define GD_INTERNAL_HELPER static
+#endif
+
+/* 0 - not initialized, 1 - being initialized, 2 - initialized */
+typedef volatile long gd_internal_once_t;
+
+#if defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC) || (defined(GD_COMPILER_GCC) && GD_COMPILER_VERSION >= GD_MAKE_VERSION(4, 7, 0))
+    #define GD_INTERNAL_ONCE_LOAD(once) __atomic_load_n((once), __ATOMIC_ACQUIRE)
+    #define GD_INTERNAL_ONCE_STORE(once, value) __atomic_store_n((once), (value), __ATOMIC_RELEASE)
+    static int gd_internal_once_claim(gd_internal_once_t* once)
+    {
+        long expected = 0;
+        return __atomic_compare_exchange_n(once, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
+#elif defined(GD_COMPILER_MSVC)
+    #if GD_NO_EXTERNAL_INCLUDES
+        long _InterlockedCompareExchange(long volatile*, long, long);
+        long _InterlockedExchange(long volatile*, long);
+        #pragma intrinsic(_InterlockedCompareExchange, _InterlockedExchange)
+    #endif
+    #define GD_INTERNAL_ONCE_LOAD(once) _InterlockedCompareExchange((once), 0, 0)
+    #define GD_INTERNAL_ONCE_STORE(once, value) ((void)_InterlockedExchange((once), (value)))
+    static int gd_internal_once_claim(gd_internal_once_t* once)
+    {
+        return _InterlockedCompareExchange(once, 1, 0) == 0;
+    }
+#else
+    /* NOTE: Without atomics the first call has to happen before any threads are started */
+    #define GD_INTERNAL_ONCE_LOAD(once) (*(once))
+    #define GD_INTERNAL_ONCE_STORE(once, value) ((void)(*(once) = (value)))
+    static int gd_internal_once_claim(gd_internal_once_t* once)
+    {
+        return *once == 0 ? (*once = 1) : 0;
+    }
+#endif
+
+/* Returns 1 if the caller has to initialize and then call gd_internal_once_end, 0 if it is already done */
+GD_INTERNAL_HELPER int gd_internal_once_begin(gd_internal_once_t* once)
+{
+    if (GD_INTERNAL_ONCE_LOAD(once) == 2)
+        return 0;
+    if (gd_internal_once_claim(once))
+        return 1;
+    while (GD_INTERNAL_ONCE_LOAD(once) != 2)
+    {
+#if GD_INTERNAL_HAS_POSIX
+        sched_yield();
+#elif defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+        SwitchToThread();
+#endif
+    }
+    return 0;
+}
+
+GD_INTERNAL_HELPER void gd_internal_once_end(gd_internal_once_t* once)
+{
+    GD_INTERNAL_ONCE_STORE(once, 2);
+}
+
+#if GD_INTERNAL_HAS_POSIX
+/* Reads a whole (small) file with the trailing whitespace removed, returns its length or -1 */
+GD_INTERNAL_HELPER int gd_internal_read_file(const char* path, char* buffer, int size)
+{
+    int fd, length = 0;
+    long result;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    while (length < size - 1 && (result = read(fd, buffer + length, (size_t)(size - 1 - length))) > 0)
+        length += (int)result;
+    close(fd);
+
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == ' ' || buffer[length - 1] == '\t'))
+        length--;
+    buffer[length] = '\0';
+    return length;
+}
+#endif
+
+/* Parses a decimal number, skipping leading whitespace, and stores where it ended */
+GD_INTERNAL_HELPER gd_u64_t gd_internal_parse_u64(const char* string, const char** end)
+{
+    gd_u64_t value = 0;
+    while (*string == ' ' || *string == '\t' || *string == '\n')
+        string++;
+    while (*string >= '0' && *string <= '9')
+        value = value * 10 + (gd_u64_t)(*string++ - '0');
+    if (end)
+        *end = string;
+    return value;
+}
+
+/* Parses a size like the ones in sysfs ("32K", "1M" or just bytes) */
+GD_INTERNAL_HELPER gd_u64_t gd_internal_parse_size(const char* string)
+{
+    const char* end;
+    gd_u64_t value = gd_internal_parse_u64(string, &end);
+    switch (*end)
+    {
+        case 'K': case 'k': return value << 10;
+        case 'M': case 'm': return value << 20;
+        case 'G': case 'g': return value << 30;
+        default: return value;
+    }
+}
+
+/* Counts the CPUs in a Linux CPU list, e.g. "0-3,8-11" */
+GD_INTERNAL_HELPER unsigned int gd_internal_count_cpu_list(const char* list)
+{
+    unsigned int count = 0;
+    while (*list >= '0' && *list <= '9')
+    {
+        const char* end;
+        gd_u64_t first = gd_internal_parse_u64(list, &end), last = first;
+        if (*end == '-')
+            last = gd_internal_parse_u64(end + 1, &end);
+        if (last >= first)
+            count += (unsigned int)(last - first + 1);
+        if (*end != ',')
+            break;
+        list = end + 1;
+    }
+    return count;
+}
+
+/* Builds "<prefix><number><suffix>", truncating it to the buffer size */
+GD_INTERNAL_HELPER void gd_internal_make_path(char* buffer, int size, const char* prefix, unsigned int number, const char* suffix)
+{
+    char digits[12];
+    int length = 0, count = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + number % 10);
+        number /= 10;
+    } while (number);
+
+    while (*prefix && length < size - 1)
+        buffer[length++] = *prefix++;
+    while (count && length < size - 1)
+        buffer[length++] = digits[--count];
+    while (*suffix && length < size - 1)
+        buffer[length++] = *suffix++;
+    buffer[length] = '\0';
+}
+
+/* The few string.h functions the probes need, spelled out without external includes */
+#if !GD_NO_EXTERNAL_INCLUDES
+    #define gd_internal_memset memset
+    #define gd_internal_memcpy memcpy
+    #define gd_internal_strcmp strcmp
+    #define gd_internal_strstr strstr
+#else
+    GD_INTERNAL_HELPER void gd_internal_memset(void* buffer, int value, unsigned long size)
+    {
+        unsigned char* bytes = (unsigned char*)buffer;
+        while (size--)
+            *bytes++ = (unsigned char)value;
+    }
+
+    GD_INTERNAL_HELPER void gd_internal_memcpy(void* destination, const void* source, unsigned long size)
+    {
+        unsigned char* to = (unsigned char*)destination;
+        const unsigned char* from = (const unsigned char*)source;
+        while (size--)
+            *to++ = *from++;
+    }
+
+    GD_INTERNAL_HELPER int gd_internal_strcmp(const char* a, const char* b)
+    {
+        while (*a && *a == *b)
+        {
+            a++;
+            b++;
+        }
+        return (int)(unsigned char)*a - (int)(unsigned char)*b;
+    }
+
+    GD_INTERNAL_HELPER const char* gd_internal_strstr(const char* string, const char* part)
+    {
+        unsigned long i;
+        for (; *string; string++)
+        {
+            for (i = 0; part[i] && string[i] == part[i]; i++)
+                ;
+            if (!part[i])
+                return string;
+        }
+        return *part ? 0 : string;
+    }
+#endif
+
+/* Copies a string, truncating it to the buffer size */
+GD_INTERNAL_HELPER void gd_internal_copy_string(char* buffer, unsigned long size, const char* string)
+{
+    unsigned long length = 0;
+
+    while (string[length] && length < size - 1)
+        length++;
+    gd_internal_memcpy(buffer, string, length);
+    buffer[length] = '\0';
+}
+
+#if GD_INTERNAL_HAS_SYSCTLBYNAME
+/* Reads an integer sysctl of any width, returns 0 if it does not exist */
+GD_INTERNAL_HELPER gd_u64_t gd_internal_sysctl_u64(const char* name)
+{
+    union { unsigned int u32; gd_u64_t u64; } value;
+    size_t size = sizeof(value);
+    value.u64 = 0;
+    if (sysctlbyname(name, &value, &size, NULL, 0) != 0)
+        return 0;
+    return size == sizeof(value.u32) ? value.u32 : value.u64;
+}
+#endif
+
+/* CPU features */
+
+#ifdef GD_INTERNAL_SPLIT_U64
+GD_INTERNAL_API_DATA volatile unsigned int gd_internal_cpu_features[4] = { 0, 0, 0, 0 };
+#else
+GD_INTERNAL_API_DATA volatile gd_cpu_features_t gd_internal_cpu_features = 0;
+#endif
+
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+#if defined(GD_COMPILER_GCC) || defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC)
+    #define GD_INTERNAL_HAS_CPUID 1
+    static void gd_internal_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+    {
+        __asm__ __volatile__("cpuid" : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3]) : "a"(leaf), "c"(subleaf));
+    }
+
+    static gd_u64_t gd_internal_xgetbv(unsigned int index)
+    {
+        unsigned int low, high;
+        /* NOTE: This is xgetbv, spelled out for assemblers that do not know it */
+        __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(low), "=d"(high) : "c"(index));
+        return ((gd_u64_t)high << 32) | low;
+    }
+#elif defined(GD_COMPILER_MSVC)
+    #define GD_INTERNAL_HAS_CPUID 1
+    #if GD_NO_EXTERNAL_INCLUDES
+        void __cpuidex(int cpuInfo[4], int function_id, int subfunction_id);
+        unsigned __int64 _xgetbv(unsigned int);
+        #pragma intrinsic(__cpuidex, _xgetbv)
+    #endif
+    static void gd_internal_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+    {
+        __cpuidex((int*)regs, (int)leaf, (int)subleaf);
+    }
+
+    static gd_u64_t gd_internal_xgetbv(unsigned int index)
+    {
+        return _xgetbv(index);
+    }
+#else
+    #define GD_INTERNAL_HAS_CPUID 0
+#endif
+#endif
+
+#if GD_INTERNAL_HAS_SYSCTLBYNAME
+GD_INTERNAL_HELPER int gd_internal_sysctl_flag(const char* name)
+{
+    return gd_internal_sysctl_u64(name) != 0;
+}
+#endif
+
+GD_API gd_cpu_features_t gd_cpu_features_probe(void)
+{
+    gd_cpu_features_t features = 0;
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    unsigned int regs[4];
+    unsigned int max_leaf, max_extended_leaf, max_subleaf = 0, leaf1_ecx = 0;
+    gd_u64_t xcr0 = 0;
+    int avx_enabled, avx512_enabled, amx_enabled;
+
+    gd_internal_cpuid(0, 0, regs);
+    max_leaf = regs[0];
+
+    if (max_leaf >= 1)
+    {
+        gd_internal_cpuid(1, 0, regs);
+        leaf1_ecx = regs[2];
+        if (regs[3] & (1u << 25)) features |= GD_CPU_FEATURE_SSE;
+        if (regs[3] & (1u << 26)) features |= GD_CPU_FEATURE_SSE2;
+        if (regs[3] & (1u << 8))  features |= GD_CPU_FEATURE_CX8;
+        if (regs[2] & (1u << 0))  features |= GD_CPU_FEATURE_SSE3;
+        if (regs[2] & (1u << 1))  features |= GD_CPU_FEATURE_PCLMULQDQ;
+        if (regs[2] & (1u << 9))  features |= GD_CPU_FEATURE_SSSE3;
+        if (regs[2] & (1u << 13)) features |= GD_CPU_FEATURE_CX16;
+        if (regs[2] & (1u << 19)) features |= GD_CPU_FEATURE_SSE4_1;
+        if (regs[2] & (1u << 20)) features |= GD_CPU_FEATURE_SSE4_2;
+        if (regs[2] & (1u << 22)) features |= GD_CPU_FEATURE_MOVBE;
+        if (regs[2] & (1u << 23)) features |= GD_CPU_FEATURE_POPCNT;
+        if (regs[2] & (1u << 25)) features |= GD_CPU_FEATURE_AES;
+        if (regs[2] & (1u << 30)) features |= GD_CPU_FEATURE_RDRAND;
+        if (regs[2] & (1u << 31)) features |= GD_CPU_FEATURE_HYPERVISOR;
+        /* The OS has to save the wide registers on context switches, which is reported in XCR0 */
+        if (regs[2] & (1u << 27))
+            xcr0 = gd_internal_xgetbv(0);
+    }
+
+    avx_enabled = (xcr0 & 0x6) == 0x6;
+    avx512_enabled = avx_enabled && (xcr0 & 0xE0) == 0xE0;
+    amx_enabled = (xcr0 & 0x60000) == 0x60000;
+
+    if (avx_enabled)
+    {
+        if (leaf1_ecx & (1u << 28)) features |= GD_CPU_FEATURE_AVX;
+        if (leaf1_ecx & (1u << 12)) features |= GD_CPU_FEATURE_FMA;
+        if (leaf1_ecx & (1u << 29)) features |= GD_CPU_FEATURE_F16C;
+    }
+
+    if (max_leaf >= 7)
+    {
+        gd_internal_cpuid(7, 0, regs);
+        max_subleaf = regs[0];
+        if (regs[1] & (1u << 3))  features |= GD_CPU_FEATURE_BMI1;
+        if (regs[1] & (1u << 8))  features |= GD_CPU_FEATURE_BMI2;
+        if (regs[1] & (1u << 9))  features |= GD_CPU_FEATURE_ERMS;
+        if (regs[1] & (1u << 18)) features |= GD_CPU_FEATURE_RDSEED;
+        if (regs[1] & (1u << 19)) features |= GD_CPU_FEATURE_ADX;
+        if (regs[1] & (1u << 29)) features |= GD_CPU_FEATURE_SHA;
+        if (regs[2] & (1u << 8))  features |= GD_CPU_FEATURE_GFNI;
+        if (regs[3] & (1u << 4))  features |= GD_CPU_FEATURE_FSRM;
+        if (avx_enabled)
+        {
+            if (regs[1] & (1u << 5))  features |= GD_CPU_FEATURE_AVX2;
+            if (regs[2] & (1u << 9))  features |= GD_CPU_FEATURE_VAES;
+            if (regs[2] & (1u << 10)) features |= GD_CPU_FEATURE_VPCLMULQDQ;
+        }
+        if (avx512_enabled)
+        {
+            if (regs[1] & (1u << 16)) features |= GD_CPU_FEATURE_AVX512F;
+            if (regs[1] & (1u << 17)) features |= GD_CPU_FEATURE_AVX512DQ;
+            if (regs[1] & (1u << 21)) features |= GD_CPU_FEATURE_AVX512IFMA;
+            if (regs[1] & (1u << 28)) features |= GD_CPU_FEATURE_AVX512CD;
+            if (regs[1] & (1u << 30)) features |= GD_CPU_FEATURE_AVX512BW;
+            if (regs[1] & (1u << 31)) features |= GD_CPU_FEATURE_AVX512VL;
+            if (regs[2] & (1u << 1))  features |= GD_CPU_FEATURE_AVX512VBMI;
+            if (regs[2] & (1u << 6))  features |= GD_CPU_FEATURE_AVX512VBMI2;
+            if (regs[2] & (1u << 11)) features |= GD_CPU_FEATURE_AVX512VNNI;
+            if (regs[2] & (1u << 12)) features |= GD_CPU_FEATURE_AVX512BITALG;
+            if (regs[2] & (1u << 14)) features |= GD_CPU_FEATURE_AVX512VPOPCNTDQ;
+            if (regs[3] & (1u << 23)) features |= GD_CPU_FEATURE_AVX512FP16;
+        }
+        if (amx_enabled)
+        {
+            if (regs[3] & (1u << 22)) features |= GD_CPU_FEATURE_AMX_BF16;
+            if (regs[3] & (1u << 24)) features |= GD_CPU_FEATURE_AMX_TILE;
+            if (regs[3] & (1u << 25)) features |= GD_CPU_FEATURE_AMX_INT8;
+        }
+    }
+
+    if (max_leaf >= 7 && max_subleaf >= 1)
+    {
+        gd_internal_cpuid(7, 1, regs);
+        if (avx_enabled && (regs[0] & (1u << 4)))
+            features |= GD_CPU_FEATURE_AVXVNNI;
+        if (avx512_enabled && (regs[0] & (1u << 5)))
+            features |= GD_CPU_FEATURE_AVX512BF16;
+        if (avx512_enabled && (regs[3] & (1u << 19)) && max_leaf >= 0x24)
+        {
+            unsigned int version;
+            gd_internal_cpuid(0x24, 0, regs);
+            version = regs[1] & 0xFF;
+            if (version >= 1) features |= GD_CPU_FEATURE_AVX10_1;
+            if (version >= 2) features |= GD_CPU_FEATURE_AVX10_2;
+        }
+    }
+
+    gd_internal_cpuid(0x80000000, 0, regs);
+    max_extended_leaf = regs[0];
+    if (max_extended_leaf >= 0x80000001)
+    {
+        gd_internal_cpuid(0x80000001, 0, regs);
+        if (regs[2] & (1u << 5))  features |= GD_CPU_FEATURE_LZCNT;
+        if (regs[3] & (1u << 27)) features |= GD_CPU_FEATURE_RDTSCP;
+    }
+    if (max_extended_leaf >= 0x80000007)
+    {
+        gd_internal_cpuid(0x80000007, 0, regs);
+        if (regs[3] & (1u << 8)) features |= GD_CPU_FEATURE_INVARIANT_TSC;
+    }
+#elif defined(GD_ARCH_AARCH64) && (GD_INTERNAL_HAS_GETAUXVAL || (defined(GD_OS_FREEBSD) && !GD_NO_EXTERNAL_INCLUDES))
+    /* NOTE: FreeBSD uses the same HWCAP layout as Linux */
+    unsigned long hwcap = 0, hwcap2 = 0;
+    #if GD_INTERNAL_HAS_GETAUXVAL
+    hwcap = getauxval(AT_HWCAP);
+    hwcap2 = getauxval(AT_HWCAP2);
+    #else
+    elf_aux_info(AT_HWCAP, &hwcap, sizeof(hwcap));
+    elf_aux_info(AT_HWCAP2, &hwcap2, sizeof(hwcap2));
+    #endif
+    if (hwcap & (1ul << 1))  features |= GD_CPU_FEATURE_NEON;
+    if (hwcap & (1ul << 3))  features |= GD_CPU_FEATURE_AES;
+    if (hwcap & (1ul << 4))  features |= GD_CPU_FEATURE_PMULL;
+    if (hwcap & (1ul << 5))  features |= GD_CPU_FEATURE_SHA1;
+    if (hwcap & (1ul << 6))  features |= GD_CPU_FEATURE_SHA2;
+    if (hwcap & (1ul << 7))  features |= GD_CPU_FEATURE_CRC32;
+    if (hwcap & (1ul << 8))  features |= GD_CPU_FEATURE_LSE;
+    if (hwcap & (1ul << 10)) features |= GD_CPU_FEATURE_FP16;
+    if (hwcap & (1ul << 15)) features |= GD_CPU_FEATURE_RCPC;
+    if (hwcap & (1ul << 17)) features |= GD_CPU_FEATURE_SHA3;
+    if (hwcap & (1ul << 20)) features |= GD_CPU_FEATURE_DOTPROD;
+    if (hwcap & (1ul << 21)) features |= GD_CPU_FEATURE_SHA512;
+    if (hwcap & (1ul << 22)) features |= GD_CPU_FEATURE_SVE;
+    if (hwcap & (1ul << 25)) features |= GD_CPU_FEATURE_LSE2;
+    if (hwcap2 & (1ul << 1))  features |= GD_CPU_FEATURE_SVE2;
+    if (hwcap2 & (1ul << 13)) features |= GD_CPU_FEATURE_I8MM;
+    if (hwcap2 & (1ul << 14)) features |= GD_CPU_FEATURE_BF16;
+    if (hwcap2 & (1ul << 16)) features |= GD_CPU_FEATURE_RNG;
+    if (hwcap2 & (1ul << 23)) features |= GD_CPU_FEATURE_SME;
+#elif defined(GD_ARCH_AARCH64) && defined(GD_OS_GENERIC_APPLE) && !GD_NO_EXTERNAL_INCLUDES
+    /* Every Apple AArch64 CPU has NEON, the crypto extensions and CRC32 */
+    features |= GD_CPU_FEATURE_NEON | GD_CPU_FEATURE_AES | GD_CPU_FEATURE_PMULL
+        | GD_CPU_FEATURE_SHA1 | GD_CPU_FEATURE_SHA2 | GD_CPU_FEATURE_CRC32;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_FP16")) features |= GD_CPU_FEATURE_FP16;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_SHA3")) features |= GD_CPU_FEATURE_SHA3;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_SHA512")) features |= GD_CPU_FEATURE_SHA512;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_LSE") || gd_internal_sysctl_flag("hw.optional.armv8_1_atomics")) features |= GD_CPU_FEATURE_LSE;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_LSE2")) features |= GD_CPU_FEATURE_LSE2;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_LRCPC")) features |= GD_CPU_FEATURE_RCPC;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_DotProd")) features |= GD_CPU_FEATURE_DOTPROD;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_I8MM")) features |= GD_CPU_FEATURE_I8MM;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_BF16")) features |= GD_CPU_FEATURE_BF16;
+    if (gd_internal_sysctl_flag("hw.optional.arm.FEAT_SME")) features |= GD_CPU_FEATURE_SME;
+#elif defined(GD_ARCH_AARCH64) && defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    features |= GD_CPU_FEATURE_NEON;
+    if (IsProcessorFeaturePresent(30)) /* PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE */
+        features |= GD_CPU_FEATURE_AES | GD_CPU_FEATURE_PMULL | GD_CPU_FEATURE_SHA1 | GD_CPU_FEATURE_SHA2;
+    if (IsProcessorFeaturePresent(31)) features |= GD_CPU_FEATURE_CRC32; /* PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE */
+    if (IsProcessorFeaturePresent(34)) features |= GD_CPU_FEATURE_LSE; /* PF_ARM_V81_ATOMIC_INSTRUCTIONS_AVAILABLE */
+    if (IsProcessorFeaturePresent(43)) features |= GD_CPU_FEATURE_DOTPROD; /* PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE */
+#elif defined(GD_ARCH_ARM) && GD_INTERNAL_HAS_GETAUXVAL
+    unsigned long hwcap = getauxval(AT_HWCAP), hwcap2 = getauxval(AT_HWCAP2);
+    if (hwcap & (1ul << 12)) features |= GD_CPU_FEATURE_NEON;
+    if (hwcap2 & (1ul << 0)) features |= GD_CPU_FEATURE_AES;
+    if (hwcap2 & (1ul << 1)) features |= GD_CPU_FEATURE_PMULL;
+    if (hwcap2 & (1ul << 2)) features |= GD_CPU_FEATURE_SHA1;
+    if (hwcap2 & (1ul << 3)) features |= GD_CPU_FEATURE_SHA2;
+    if (hwcap2 & (1ul << 4)) features |= GD_CPU_FEATURE_CRC32;
+#elif defined(GD_ARCH_RISCV) && GD_INTERNAL_HAS_GETAUXVAL
+    /* riscv_hwprobe (Linux 6.4+), struct riscv_hwprobe spelled out for older kernel headers */
+    struct { gd_i64_t key; gd_u64_t value; } pair;
+    pair.key = 4; /* RISCV_HWPROBE_KEY_IMA_EXT_0 */
+    pair.value = 0;
+    if (syscall(258, &pair, 1, 0, NULL, 0) == 0 && pair.key != -1)
+    {
+        if (pair.value & ((gd_u64_t)1 << 0))  features |= GD_CPU_FEATURE_FD;
+        if (pair.value & ((gd_u64_t)1 << 1))  features |= GD_CPU_FEATURE_C;
+        if (pair.value & ((gd_u64_t)1 << 2))  features |= GD_CPU_FEATURE_V;
+        if (pair.value & ((gd_u64_t)1 << 3))  features |= GD_CPU_FEATURE_ZBA;
+        if (pair.value & ((gd_u64_t)1 << 4))  features |= GD_CPU_FEATURE_ZBB;
+        if (pair.value & ((gd_u64_t)1 << 5))  features |= GD_CPU_FEATURE_ZBS;
+        if (pair.value & ((gd_u64_t)1 << 6))  features |= GD_CPU_FEATURE_ZICBOZ;
+        if (pair.value & ((gd_u64_t)1 << 7))  features |= GD_CPU_FEATURE_ZBC;
+        if (pair.value & ((gd_u64_t)1 << 27)) features |= GD_CPU_FEATURE_ZFH;
+        if (pair.value & ((gd_u64_t)1 << 30)) features |= GD_CPU_FEATURE_ZVFH;
+        if (pair.value & ((gd_u64_t)1 << 17)) features |= GD_CPU_FEATURE_ZVBB;
+        if (pair.value & ((gd_u64_t)1 << 33)) features |= GD_CPU_FEATURE_ZTSO;
+        if (pair.value & ((gd_u64_t)1 << 34)) features |= GD_CPU_FEATURE_ZACAS;
+        if (pair.value & ((gd_u64_t)1 << 35)) features |= GD_CPU_FEATURE_ZICOND;
+    }
+    else
+    {
+        /* Older kernels only report the single letter extensions */
+        unsigned long hwcap = getauxval(AT_HWCAP);
+        if ((hwcap & (1ul << ('F' - 'A'))) && (hwcap & (1ul << ('D' - 'A')))) features |= GD_CPU_FEATURE_FD;
+        if (hwcap & (1ul << ('C' - 'A'))) features |= GD_CPU_FEATURE_C;
+        if (hwcap & (1ul << ('V' - 'A'))) features |= GD_CPU_FEATURE_V;
+    }
+#elif defined(GD_ARCH_POWERPC) && GD_INTERNAL_HAS_GETAUXVAL
+    unsigned long hwcap = getauxval(AT_HWCAP), hwcap2 = getauxval(AT_HWCAP2);
+    if (hwcap & 0x10000000ul)  features |= GD_CPU_FEATURE_ALTIVEC;
+    if (hwcap & 0x00000080ul)  features |= GD_CPU_FEATURE_VSX;
+    if (hwcap2 & 0x80000000ul) features |= GD_CPU_FEATURE_POWER8;
+    if (hwcap2 & 0x00800000ul) features |= GD_CPU_FEATURE_POWER9;
+    if (hwcap2 & 0x00040000ul) features |= GD_CPU_FEATURE_POWER10;
+#elif defined(GD_ARCH_LOONGARCH) && GD_INTERNAL_HAS_GETAUXVAL
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    if (hwcap & (1ul << 4)) features |= GD_CPU_FEATURE_LSX;
+    if (hwcap & (1ul << 5)) features |= GD_CPU_FEATURE_LASX;
+#else
+    /* Nothing to ask at runtime, so the features the compiler was allowed to use are all that is known */
+    features = gd_cpu_features_baseline();
+#endif
+
+    return features | GD_CPU_FEATURE_PROBED;
+}
+
+GD_API const char* gd_cpu_feature_name(gd_cpu_features_t feature)
+{
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    static const char* const names[GD_CPU_FEATURE_COUNT] = {
+        "sse", "sse2", "sse3", "ssse3", "sse4.1", "sse4.2", "popcnt", "avx", "avx2", "fma",
+        "f16c", "bmi1", "bmi2", "lzcnt", "movbe", "aes", "pclmulqdq", "sha", "avx512f", "avx512cd",
+        "avx512bw", "avx512dq", "avx512vl", "avx512ifma", "avx512vbmi", "avx512vbmi2", "avx512vnni",
+        "avx512bitalg", "avx512vpopcntdq", "avx512bf16", "avx512fp16", "avx10.1", "avx10.2",
+        "avxvnni", "gfni", "vaes", "vpclmulqdq", "amx-tile", "amx-int8", "amx-bf16", "adx",
+        "rdrand", "rdseed", "erms", "fsrm", "cx8", "cx16", "rdtscp", "invariant-tsc", "hypervisor"
+    };
+#elif defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)
+    static const char* const names[GD_CPU_FEATURE_COUNT] = {
+        "neon", "fp16", "aes", "pmull", "sha1", "sha2", "sha3", "sha512", "crc32", "lse",
+        "lse2", "rcpc", "dotprod", "i8mm", "bf16", "sve", "sve2", "sme", "rng"
+    };
+#elif defined(GD_ARCH_RISCV)
+    static const char* const names[GD_CPU_FEATURE_COUNT] = {
+        "fd", "c", "v", "zba", "zbb", "zbc", "zbs", "zicboz", "zicond", "zfh", "zvfh", "zvbb",
+        "zacas", "ztso"
+    };
+#elif defined(GD_ARCH_POWERPC)
+    static const char* const names[GD_CPU_FEATURE_COUNT] = {
+        "altivec", "vsx", "power8", "power9", "power10"
+    };
+#elif defined(GD_ARCH_LOONGARCH)
+    static const char* const names[GD_CPU_FEATURE_COUNT] = {
+        "lsx", "lasx"
+    };
+#endif
+    int bit;
+    for (bit = 0; bit < GD_CPU_FEATURE_COUNT; bit++)
+    {
+        if (feature == GD_CPU_FEATURE(bit))
+        {
+#if GD_CPU_FEATURE_COUNT > 0
+            return names[bit];
+#endif
+        }
+    }
+    return "Unknown";
+}
+
+/* CPU model */
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+typedef struct gd_internal_x86_model
+{
+    unsigned char model;
+    gd_uarch_t uarch;
+} gd_internal_x86_model_t;
+
+/* Display models of family 6, Skylake-SP (0x55) is told apart from its successors by the stepping */
+static const gd_internal_x86_model_t gd_internal_intel_models[] = {
+    { 0x2A, GD_UARCH_SANDY_BRIDGE }, { 0x2D, GD_UARCH_SANDY_BRIDGE },
+    { 0x3A, GD_UARCH_IVY_BRIDGE }, { 0x3E, GD_UARCH_IVY_BRIDGE },
+    { 0x3C, GD_UARCH_HASWELL }, { 0x3F, GD_UARCH_HASWELL }, { 0x45, GD_UARCH_HASWELL }, { 0x46, GD_UARCH_HASWELL },
+    { 0x3D, GD_UARCH_BROADWELL }, { 0x47, GD_UARCH_BROADWELL }, { 0x4F, GD_UARCH_BROADWELL }, { 0x56, GD_UARCH_BROADWELL },
+    { 0x4E, GD_UARCH_SKYLAKE }, { 0x5E, GD_UARCH_SKYLAKE }, { 0x8E, GD_UARCH_SKYLAKE }, { 0x9E, GD_UARCH_SKYLAKE },
+    { 0xA5, GD_UARCH_SKYLAKE }, { 0xA6, GD_UARCH_SKYLAKE },
+    { 0x55, GD_UARCH_SKYLAKE_X },
+    { 0x7D, GD_UARCH_ICE_LAKE }, { 0x7E, GD_UARCH_ICE_LAKE },
+    { 0x6A, GD_UARCH_ICE_LAKE_X }, { 0x6C, GD_UARCH_ICE_LAKE_X },
+    { 0x8C, GD_UARCH_TIGER_LAKE }, { 0x8D, GD_UARCH_TIGER_LAKE },
+    { 0xA7, GD_UARCH_ROCKET_LAKE },
+    { 0x97, GD_UARCH_ALDER_LAKE }, { 0x9A, GD_UARCH_ALDER_LAKE },
+    { 0xB7, GD_UARCH_RAPTOR_LAKE }, { 0xBA, GD_UARCH_RAPTOR_LAKE }, { 0xBF, GD_UARCH_RAPTOR_LAKE },
+    { 0xAA, GD_UARCH_METEOR_LAKE }, { 0xAC, GD_UARCH_METEOR_LAKE },
+    { 0xC5, GD_UARCH_ARROW_LAKE }, { 0xC6, GD_UARCH_ARROW_LAKE },
+    { 0xBD, GD_UARCH_LUNAR_LAKE },
+    { 0x8F, GD_UARCH_SAPPHIRE_RAPIDS },
+    { 0xCF, GD_UARCH_EMERALD_RAPIDS },
+    { 0xAD, GD_UARCH_GRANITE_RAPIDS }, { 0xAE, GD_UARCH_GRANITE_RAPIDS },
+    { 0xAF, GD_UARCH_SIERRA_FOREST }
+};
+
+static gd_uarch_t gd_internal_uarch_amd(unsigned int family, unsigned int model)
+{
+    switch (family)
+    {
+    case 0x17:
+        if (model == 0x08 || model == 0x18)
+            return GD_UARCH_ZEN_PLUS;
+        return model < 0x30 ? GD_UARCH_ZEN : GD_UARCH_ZEN2;
+    case 0x19:
+        /* Genoa, Raphael, Phoenix and Bergamo, the rest of the family is Zen 3 */
+        if ((model >= 0x10 && model < 0x20) || (model >= 0x60 && model < 0x80) || (model >= 0xA0 && model < 0xB0))
+            return GD_UARCH_ZEN4;
+        return GD_UARCH_ZEN3;
+    case 0x1A:
+        return GD_UARCH_ZEN5;
+    default:
+        return GD_UARCH_UNKNOWN;
+    }
+}
+
+static void gd_internal_cpu_model_probe_cpuid(gd_cpu_model_t* model)
+{
+    unsigned int regs[4], base_family, i;
+    char vendor[13];
+    const char* brand;
+
+    gd_internal_cpuid(0, 0, regs);
+    gd_internal_memcpy(vendor, &regs[1], 4);
+    gd_internal_memcpy(vendor + 4, &regs[3], 4);
+    gd_internal_memcpy(vendor + 8, &regs[2], 4);
+    vendor[12] = '\0';
+    if (gd_internal_strcmp(vendor, "GenuineIntel") == 0)
+        model->vendor = GD_CPU_VENDOR_INTEL;
+    else if (gd_internal_strcmp(vendor, "AuthenticAMD") == 0)
+        model->vendor = GD_CPU_VENDOR_AMD;
+    else if (gd_internal_strcmp(vendor, "HygonGenuine") == 0)
+        model->vendor = GD_CPU_VENDOR_HYGON;
+    else if (gd_internal_strcmp(vendor, "CentaurHauls") == 0 || gd_internal_strcmp(vendor, "  Shanghai  ") == 0)
+        model->vendor = GD_CPU_VENDOR_ZHAOXIN;
+
+    if (regs[0] >= 1)
+    {
+        gd_internal_cpuid(1, 0, regs);
+        base_family = (regs[0] >> 8) & 0xF;
+        model->family = base_family == 0xF ? base_family + ((regs[0] >> 20) & 0xFF) : base_family;
+        model->model = (regs[0] >> 4) & 0xF;
+        if (base_family == 0x6 || base_family == 0xF)
+            model->model |= ((regs[0] >> 16) & 0xF) << 4;
+        model->stepping = regs[0] & 0xF;
+    }
+
+    gd_internal_cpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000004u)
+    {
+        char buffer[49];
+        for (i = 0; i < 3; i++)
+            gd_internal_cpuid(0x80000002u + i, 0, (unsigned int*)(void*)(buffer + i * 16));
+        buffer[48] = '\0';
+        for (brand = buffer; *brand == ' '; brand++)
+            ;
+        gd_internal_copy_string(model->brand, sizeof(model->brand), brand);
+    }
+
+    if (model->vendor == GD_CPU_VENDOR_INTEL && model->family == 6)
+    {
+        for (i = 0; i < sizeof(gd_internal_intel_models) / sizeof(gd_internal_intel_models[0]); i++)
+        {
+            if (gd_internal_intel_models[i].model == model->model)
+                model->uarch = gd_internal_intel_models[i].uarch;
+        }
+        if (model->uarch == GD_UARCH_SKYLAKE_X && model->stepping >= 10)
+            model->uarch = GD_UARCH_COOPER_LAKE;
+        else if (model->uarch == GD_UARCH_SKYLAKE_X && model->stepping >= 5)
+            model->uarch = GD_UARCH_CASCADE_LAKE;
+    }
+    else if (model->vendor == GD_CPU_VENDOR_AMD)
+        model->uarch = gd_internal_uarch_amd(model->family, model->model);
+    else if (model->vendor == GD_CPU_VENDOR_HYGON && model->family == 0x18)
+        model->uarch = GD_UARCH_ZEN;
+}
+#endif
+
+#if defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)
+typedef struct gd_internal_arm_part
+{
+    unsigned char implementer;
+    unsigned short part;
+    gd_uarch_t uarch;
+} gd_internal_arm_part_t;
+
+static const gd_internal_arm_part_t gd_internal_arm_parts[] = {
+    { 0x41, 0xD03, GD_UARCH_CORTEX_A53 }, { 0x41, 0xD05, GD_UARCH_CORTEX_A55 }, { 0x41, 0xD08, GD_UARCH_CORTEX_A72 },
+    { 0x41, 0xD0B, GD_UARCH_CORTEX_A76 }, { 0x41, 0xD41, GD_UARCH_CORTEX_A78 }, { 0x41, 0xD44, GD_UARCH_CORTEX_X1 },
+    { 0x41, 0xD46, GD_UARCH_CORTEX_A510 }, { 0x41, 0xD47, GD_UARCH_CORTEX_A710 }, { 0x41, 0xD48, GD_UARCH_CORTEX_X2 },
+    { 0x41, 0xD4D, GD_UARCH_CORTEX_A715 }, { 0x41, 0xD4E, GD_UARCH_CORTEX_X3 }, { 0x41, 0xD81, GD_UARCH_CORTEX_A720 },
+    { 0x41, 0xD82, GD_UARCH_CORTEX_X4 },
+    { 0x41, 0xD0C, GD_UARCH_NEOVERSE_N1 }, { 0x41, 0xD49, GD_UARCH_NEOVERSE_N2 }, { 0x41, 0xD8E, GD_UARCH_NEOVERSE_N3 },
+    { 0x41, 0xD40, GD_UARCH_NEOVERSE_V1 }, { 0x41, 0xD4F, GD_UARCH_NEOVERSE_V2 }, { 0x41, 0xD84, GD_UARCH_NEOVERSE_V3 },
+    { 0x41, 0xD4A, GD_UARCH_NEOVERSE_E1 },
+    { 0x42, 0x516, GD_UARCH_THUNDERX2 }, { 0x43, 0x0AF, GD_UARCH_THUNDERX2 },
+    { 0x46, 0x001, GD_UARCH_A64FX },
+    { 0x48, 0xD01, GD_UARCH_TSV110 },
+    { 0x51, 0x001, GD_UARCH_ORYON },
+    { 0xC0, 0xAC3, GD_UARCH_AMPERE_ONE }
+};
+
+/* Decodes MIDR_EL1: implementer [31:24], variant [23:20], architecture [19:16], part [15:4], revision [3:0] */
+static void gd_internal_cpu_model_from_midr(gd_cpu_model_t* model, gd_u64_t midr)
+{
+    unsigned int implementer = (unsigned int)(midr >> 24) & 0xFF, i;
+
+    model->midr = midr;
+    model->family = (unsigned int)(midr >> 16) & 0xF;
+    model->model = (unsigned int)(midr >> 4) & 0xFFF;
+    model->stepping = (unsigned int)(((midr >> 20) & 0xF) << 4 | (midr & 0xF));
+    switch (implementer)
+    {
+        case 0x41: model->vendor = GD_CPU_VENDOR_ARM; break;
+        case 0x42: case 0x43: model->vendor = GD_CPU_VENDOR_CAVIUM; break;
+        case 0x46: model->vendor = GD_CPU_VENDOR_FUJITSU; break;
+        case 0x48: model->vendor = GD_CPU_VENDOR_HISILICON; break;
+        case 0x4E: model->vendor = GD_CPU_VENDOR_NVIDIA; break;
+        case 0x51: model->vendor = GD_CPU_VENDOR_QUALCOMM; break;
+        case 0x61: model->vendor = GD_CPU_VENDOR_APPLE; break;
+        case 0xC0: model->vendor = GD_CPU_VENDOR_AMPERE; break;
+        default: break;
+    }
+
+    for (i = 0; i < sizeof(gd_internal_arm_parts) / sizeof(gd_internal_arm_parts[0]); i++)
+    {
+        if (gd_internal_arm_parts[i].implementer == implementer && gd_internal_arm_parts[i].part == model->model)
+            model->uarch = gd_internal_arm_parts[i].uarch;
+    }
+    /* Apple cores as seen by Linux, the pairs of E- and P-core parts of the base, Pro and Max chips */
+    if (implementer == 0x61 && model->model >= 0x022 && model->model <= 0x029)
+        model->uarch = GD_UARCH_APPLE_M1;
+    else if (implementer == 0x61 && model->model >= 0x032 && model->model <= 0x039)
+        model->uarch = GD_UARCH_APPLE_M2;
+}
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Parses a hexadecimal number with an optional 0x prefix */
+static gd_u64_t gd_internal_parse_hex(const char* string)
+{
+    gd_u64_t value = 0;
+
+    if (string[0] == '0' && (string[1] == 'x' || string[1] == 'X'))
+        string += 2;
+    for (;; string++)
+    {
+        if (*string >= '0' && *string <= '9')
+            value = value * 16 + (gd_u64_t)(*string - '0');
+        else if (*string >= 'a' && *string <= 'f')
+            value = value * 16 + (gd_u64_t)(*string - 'a' + 10);
+        else if (*string >= 'A' && *string <= 'F')
+            value = value * 16 + (gd_u64_t)(*string - 'A' + 10);
+        else
+            return value;
+    }
+}
+
+static void gd_internal_cpu_model_probe_midr(gd_cpu_model_t* model)
+{
+    const gd_topology_t* topology = gd_topology();
+    char path[128], buffer[64];
+    unsigned int cpu = topology->cpu_count ? topology->cpus[0].id : 0, i;
+
+    /* The cores of big.LITTLE systems differ, the model of a big core is the one to tune for */
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        if (topology->cpus[i].type == GD_CORE_TYPE_PERFORMANCE)
+        {
+            cpu = topology->cpus[i].id;
+            break;
+        }
+    }
+    gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu", cpu, "/regs/identification/midr_el1");
+    if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0)
+        gd_internal_cpu_model_from_midr(model, gd_internal_parse_hex(buffer));
+}
+#endif
+#endif
+
+GD_API int gd_cpu_model_probe(gd_cpu_model_t* model)
+{
+    gd_internal_memset(model, 0, sizeof(*model));
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    gd_internal_cpu_model_probe_cpuid(model);
+#elif (defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)) && defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    gd_internal_cpu_model_probe_midr(model);
+#elif defined(GD_ARCH_AARCH64) && defined(GD_OS_GENERIC_APPLE) && GD_INTERNAL_HAS_SYSCTLBYNAME
+    /* macOS hides MIDR_EL1, the brand string names the chip, e.g. "Apple M2 Pro" */
+    {
+        size_t size = sizeof(model->brand) - 1;
+        if (sysctlbyname("machdep.cpu.brand_string", model->brand, &size, NULL, 0) == 0)
+        {
+            model->brand[size < sizeof(model->brand) ? size : sizeof(model->brand) - 1] = '\0';
+            model->vendor = GD_CPU_VENDOR_APPLE;
+            if (strstr(model->brand, "Apple M1"))
+                model->uarch = GD_UARCH_APPLE_M1;
+            else if (strstr(model->brand, "Apple M2"))
+                model->uarch = GD_UARCH_APPLE_M2;
+            else if (strstr(model->brand, "Apple M3"))
+                model->uarch = GD_UARCH_APPLE_M3;
+            else if (strstr(model->brand, "Apple M4"))
+                model->uarch = GD_UARCH_APPLE_M4;
+        }
+    }
+#elif defined(GD_ARCH_POWERPC)
+    /* The feature bits come from the ISA level the kernel reports */
+    model->vendor = GD_CPU_VENDOR_IBM;
+    if (gd_cpu_has(GD_CPU_FEATURE_POWER10))
+        model->uarch = GD_UARCH_POWER10;
+    else if (gd_cpu_has(GD_CPU_FEATURE_POWER9))
+        model->uarch = GD_UARCH_POWER9;
+    else if (gd_cpu_has(GD_CPU_FEATURE_POWER8))
+        model->uarch = GD_UARCH_POWER8;
+#endif
+
+    return model->vendor != GD_CPU_VENDOR_UNKNOWN;
+}
+
+static gd_cpu_model_t gd_internal_cpu_model;
+static gd_internal_once_t gd_internal_cpu_model_once = 0;
+
+GD_API const gd_cpu_model_t* gd_cpu_model(void)
+{
+    if (gd_internal_once_begin(&gd_internal_cpu_model_once))
+    {
+        gd_cpu_model_probe(&gd_internal_cpu_model);
+        gd_internal_once_end(&gd_internal_cpu_model_once);
+    }
+    return &gd_internal_cpu_model;
+}
+
+GD_API const char* gd_cpu_vendor_name(gd_cpu_vendor_t vendor)
+{
+    switch (vendor)
+    {
+        case GD_CPU_VENDOR_INTEL: return "Intel";
+        case GD_CPU_VENDOR_AMD: return "AMD";
+        case GD_CPU_VENDOR_HYGON: return "Hygon";
+        case GD_CPU_VENDOR_ZHAOXIN: return "Zhaoxin";
+        case GD_CPU_VENDOR_ARM: return "ARM";
+        case GD_CPU_VENDOR_APPLE: return "Apple";
+        case GD_CPU_VENDOR_QUALCOMM: return "Qualcomm";
+        case GD_CPU_VENDOR_AMPERE: return "Ampere";
+        case GD_CPU_VENDOR_NVIDIA: return "NVIDIA";
+        case GD_CPU_VENDOR_FUJITSU: return "Fujitsu";
+        case GD_CPU_VENDOR_HISILICON: return "HiSilicon";
+        case GD_CPU_VENDOR_CAVIUM: return "Cavium";
+        case GD_CPU_VENDOR_IBM: return "IBM";
+        default: return "Unknown";
+    }
+}
+
+GD_API const char* gd_uarch_name(gd_uarch_t uarch)
+{
+    switch (uarch)
+    {
+        case GD_UARCH_SANDY_BRIDGE: return "Sandy Bridge";
+        case GD_UARCH_IVY_BRIDGE: return "Ivy Bridge";
+        case GD_UARCH_HASWELL: return "Haswell";
+        case GD_UARCH_BROADWELL: return "Broadwell";
+        case GD_UARCH_SKYLAKE: return "Skylake";
+        case GD_UARCH_SKYLAKE_X: return "Skylake-X";
+        case GD_UARCH_CASCADE_LAKE: return "Cascade Lake";
+        case GD_UARCH_COOPER_LAKE: return "Cooper Lake";
+        case GD_UARCH_ICE_LAKE: return "Ice Lake";
+        case GD_UARCH_ICE_LAKE_X: return "Ice Lake-X";
+        case GD_UARCH_TIGER_LAKE: return "Tiger Lake";
+        case GD_UARCH_ROCKET_LAKE: return "Rocket Lake";
+        case GD_UARCH_ALDER_LAKE: return "Alder Lake";
+        case GD_UARCH_RAPTOR_LAKE: return "Raptor Lake";
+        case GD_UARCH_METEOR_LAKE: return "Meteor Lake";
+        case GD_UARCH_ARROW_LAKE: return "Arrow Lake";
+        case GD_UARCH_LUNAR_LAKE: return "Lunar Lake";
+        case GD_UARCH_SAPPHIRE_RAPIDS: return "Sapphire Rapids";
+        case GD_UARCH_EMERALD_RAPIDS: return "Emerald Rapids";
+        case GD_UARCH_GRANITE_RAPIDS: return "Granite Rapids";
+        case GD_UARCH_SIERRA_FOREST: return "Sierra Forest";
+        case GD_UARCH_ZEN: return "Zen";
+        case GD_UARCH_ZEN_PLUS: return "Zen+";
+        case GD_UARCH_ZEN2: return "Zen 2";
+        case GD_UARCH_ZEN3: return "Zen 3";
+        case GD_UARCH_ZEN4: return "Zen 4";
+        case GD_UARCH_ZEN5: return "Zen 5";
+        case GD_UARCH_CORTEX_A53: return "Cortex-A53";
+        case GD_UARCH_CORTEX_A55: return "Cortex-A55";
+        case GD_UARCH_CORTEX_A72: return "Cortex-A72";
+        case GD_UARCH_CORTEX_A76: return "Cortex-A76";
+        case GD_UARCH_CORTEX_A78: return "Cortex-A78";
+        case GD_UARCH_CORTEX_X1: return "Cortex-X1";
+        case GD_UARCH_CORTEX_A510: return "Cortex-A510";
+        case GD_UARCH_CORTEX_A710: return "Cortex-A710";
+        case GD_UARCH_CORTEX_X2: return "Cortex-X2";
+        case GD_UARCH_CORTEX_A715: return "Cortex-A715";
+        case GD_UARCH_CORTEX_X3: return "Cortex-X3";
+        case GD_UARCH_CORTEX_A720: return "Cortex-A720";
+        case GD_UARCH_CORTEX_X4: return "Cortex-X4";
+        case GD_UARCH_NEOVERSE_N1: return "Neoverse N1";
+        case GD_UARCH_NEOVERSE_N2: return "Neoverse N2";
+        case GD_UARCH_NEOVERSE_N3: return "Neoverse N3";
+        case GD_UARCH_NEOVERSE_V1: return "Neoverse V1";
+        case GD_UARCH_NEOVERSE_V2: return "Neoverse V2";
+        case GD_UARCH_NEOVERSE_V3: return "Neoverse V3";
+        case GD_UARCH_NEOVERSE_E1: return "Neoverse E1";
+        case GD_UARCH_APPLE_M1: return "Apple M1";
+        case GD_UARCH_APPLE_M2: return "Apple M2";
+        case GD_UARCH_APPLE_M3: return "Apple M3";
+        case GD_UARCH_APPLE_M4: return "Apple M4";
+        case GD_UARCH_AMPERE_ONE: return "AmpereOne";
+        case GD_UARCH_ORYON: return "Oryon";
+        case GD_UARCH_A64FX: return "A64FX";
+        case GD_UARCH_TSV110: return "TSV110";
+        case GD_UARCH_THUNDERX2: return "ThunderX2";
+        case GD_UARCH_POWER8: return "POWER8";
+        case GD_UARCH_POWER9: return "POWER9";
+        case GD_UARCH_POWER10: return "POWER10";
+        default: return "Unknown";
+    }
+}
+
+/* Caches */
+
+static void gd_internal_cache_add(gd_cache_info_t* info, unsigned int level, gd_cache_type_t type, gd_u64_t size,
+    unsigned int line_size, unsigned int associativity, unsigned int shared_by)
+{
+    gd_cache_t* cache;
+    unsigned int i;
+
+    if (info->count >= GD_CACHE_MAX_COUNT || level == 0 || size == 0)
+        return;
+    for (i = 0; i < info->count; i++)
+    {
+        if (info->caches[i].level == level && info->caches[i].type == type)
+            return;
+    }
+
+    cache = &info->caches[info->count++];
+    cache->level = level;
+    cache->type = type;
+    cache->size = size;
+    cache->line_size = line_size;
+    cache->associativity = associativity;
+    cache->shared_by = shared_by;
+}
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+static void gd_internal_cache_probe_cpuid(gd_cache_info_t* info)
+{
+    unsigned int regs[4];
+    unsigned int max_leaf, leaf = 0, subleaf;
+    int amd;
+
+    gd_internal_cpuid(0, 0, regs);
+    max_leaf = regs[0];
+    /* "Auth"enticAMD and "Hygo"nGenuine describe their caches in 0x8000001D, everyone else in leaf 4 */
+    amd = regs[1] == 0x68747541 || regs[1] == 0x6f677948;
+
+    if (amd)
+    {
+        gd_internal_cpuid(0x80000000, 0, regs);
+        if (regs[0] >= 0x8000001D)
+        {
+            gd_internal_cpuid(0x80000001, 0, regs);
+            if (regs[2] & (1u << 22)) /* Topology extensions */
+                leaf = 0x8000001D;
+        }
+    }
+    else if (max_leaf >= 4)
+    {
+        leaf = 4;
+    }
+    if (leaf == 0)
+        return;
+
+    for (subleaf = 0; subleaf < 16; subleaf++)
+    {
+        unsigned int type, line_size, partitions, ways, sets;
+
+        gd_internal_cpuid(leaf, subleaf, regs);
+        type = regs[0] & 0x1F;
+        if (type == 0)
+            break;
+        if (type > 3)
+            continue;
+
+        line_size = (regs[1] & 0xFFF) + 1;
+        partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+        ways = ((regs[1] >> 22) & 0x3FF) + 1;
+        sets = regs[2] + 1;
+        /* NOTE: cpuid reports the maximum number of sharing logical CPUs, not the actual one */
+        gd_internal_cache_add(info, (regs[0] >> 5) & 0x7, (gd_cache_type_t)type,
+            (gd_u64_t)ways * partitions * line_size * sets, line_size,
+            (regs[0] & (1u << 9)) ? GD_CACHE_FULLY_ASSOCIATIVE : ways, ((regs[0] >> 14) & 0xFFF) + 1);
+    }
+}
+#endif
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+static void gd_internal_cache_probe_sysfs(gd_cache_info_t* info)
+{
+    char path[128], buffer[256];
+    unsigned int index;
+
+    for (index = 0; index < 16; index++)
+    {
+        gd_cache_type_t type;
+        unsigned int level, line_size, associativity, shared_by;
+        gd_u64_t size;
+
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/type");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) < 0)
+            break;
+        if (strcmp(buffer, "Data") == 0)
+            type = GD_CACHE_TYPE_DATA;
+        else if (strcmp(buffer, "Instruction") == 0)
+            type = GD_CACHE_TYPE_INSTRUCTION;
+        else if (strcmp(buffer, "Unified") == 0)
+            type = GD_CACHE_TYPE_UNIFIED;
+        else
+            continue;
+
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/level");
+        level = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : 0;
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/size");
+        size = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? gd_internal_parse_size(buffer) : 0;
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/coherency_line_size");
+        line_size = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : 0;
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/ways_of_associativity");
+        associativity = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : 0;
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index", index, "/shared_cpu_list");
+        shared_by = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? gd_internal_count_cpu_list(buffer) : 0;
+
+        gd_internal_cache_add(info, level, type, size, line_size, associativity, shared_by);
+    }
+}
+#endif
+
+#if GD_INTERNAL_HAS_SYSCTLBYNAME
+static void gd_internal_cache_probe_sysctl(gd_cache_info_t* info)
+{
+    unsigned int line_size = (unsigned int)gd_internal_sysctl_u64("hw.cachelinesize");
+    gd_internal_cache_add(info, 1, GD_CACHE_TYPE_DATA, gd_internal_sysctl_u64("hw.l1dcachesize"), line_size, 0, 0);
+    gd_internal_cache_add(info, 1, GD_CACHE_TYPE_INSTRUCTION, gd_internal_sysctl_u64("hw.l1icachesize"), line_size, 0, 0);
+    gd_internal_cache_add(info, 2, GD_CACHE_TYPE_UNIFIED, gd_internal_sysctl_u64("hw.l2cachesize"), line_size, 0, 0);
+    gd_internal_cache_add(info, 3, GD_CACHE_TYPE_UNIFIED, gd_internal_sysctl_u64("hw.l3cachesize"), line_size, 0, 0);
+}
+#endif
+
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+static void gd_internal_cache_probe_windows(gd_cache_info_t* info)
+{
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION* buffer;
+    DWORD length = 0, i;
+
+    GetLogicalProcessorInformation(NULL, &length);
+    buffer = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)malloc(length);
+    if (buffer == NULL)
+        return;
+    if (!GetLogicalProcessorInformation(buffer, &length))
+    {
+        free(buffer);
+        return;
+    }
+    for (i = 0; i < length / sizeof(buffer[0]); i++)
+    {
+        const CACHE_DESCRIPTOR* descriptor = &buffer[i].Cache;
+        gd_cache_type_t type;
+        unsigned int shared_by = 0;
+        ULONG_PTR mask;
+
+        if (buffer[i].Relationship != RelationCache)
+            continue;
+        if (descriptor->Type == CacheData)
+            type = GD_CACHE_TYPE_DATA;
+        else if (descriptor->Type == CacheInstruction)
+            type = GD_CACHE_TYPE_INSTRUCTION;
+        else if (descriptor->Type == CacheUnified)
+            type = GD_CACHE_TYPE_UNIFIED;
+        else
+            continue;
+        for (mask = buffer[i].ProcessorMask; mask; mask &= mask - 1)
+            shared_by++;
+
+        gd_internal_cache_add(info, descriptor->Level, type, descriptor->Size, descriptor->LineSize,
+            descriptor->Associativity == 0xFF ? GD_CACHE_FULLY_ASSOCIATIVE : descriptor->Associativity, shared_by);
+    }
+    free(buffer);
+}
+#endif
+
+GD_API int gd_cache_info_probe(gd_cache_info_t* info)
+{
+    unsigned int i;
+
+    info->count = 0;
+    info->line_size = 0;
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    gd_internal_cache_probe_cpuid(info);
+#endif
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    if (info->count == 0)
+        gd_internal_cache_probe_sysfs(info);
+#endif
+#if GD_INTERNAL_HAS_SYSCTLBYNAME
+    if (info->count == 0)
+        gd_internal_cache_probe_sysctl(info);
+#endif
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    if (info->count == 0)
+        gd_internal_cache_probe_windows(info);
+#endif
+
+    for (i = 0; i < info->count; i++)
+    {
+        if (info->caches[i].level == 1 && info->caches[i].type != GD_CACHE_TYPE_INSTRUCTION)
+            info->line_size = info->caches[i].line_size;
+    }
+    if (info->line_size == 0)
+        info->line_size = GD_CACHE_LINE_SIZE;
+
+    return info->count != 0;
+}
+
+static gd_cache_info_t gd_internal_cache_info;
+static gd_internal_once_t gd_internal_cache_info_once = 0;
+
+GD_API const gd_cache_info_t* gd_cache_info(void)
+{
+    if (gd_internal_once_begin(&gd_internal_cache_info_once))
+    {
+        gd_cache_info_probe(&gd_internal_cache_info);
+        gd_internal_once_end(&gd_internal_cache_info_once);
+    }
+    return &gd_internal_cache_info;
+}
+
+GD_API gd_u64_t gd_cache_size(unsigned int level)
+{
+    const gd_cache_info_t* info = gd_cache_info();
+    unsigned int i;
+
+    for (i = 0; i < info->count; i++)
+    {
+        if (info->caches[i].level == level && info->caches[i].type != GD_CACHE_TYPE_INSTRUCTION)
+            return info->caches[i].size;
+    }
+    return 0;
+}
+
+/* Topology */
+
+/* Returns the entry of a CPU, adding it if it is not there yet */
+static gd_topology_cpu_t* gd_internal_topology_cpu(gd_topology_t* topology, unsigned int id)
+{
+    unsigned int i;
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        if (topology->cpus[i].id == id)
+            return &topology->cpus[i];
+    }
+    if (topology->cpu_count >= GD_TOPOLOGY_MAX_CPUS)
+        return 0;
+    topology->cpus[topology->cpu_count].id = id;
+    return &topology->cpus[topology->cpu_count++];
+}
+
+/* Turns the per CPU package and core ids into indices and fills in the counts */
+static void gd_internal_topology_finish(gd_topology_t* topology, const unsigned int* package_ids, const unsigned int* core_ids,
+    const unsigned int* ranks)
+{
+    unsigned int i, j, min_rank = ~0u, max_rank = 0;
+
+    topology->core_count = 0;
+    topology->package_count = 0;
+    topology->smt_width = 0;
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        gd_topology_cpu_t* cpu = &topology->cpus[i];
+
+        /* Earlier CPUs on the same package / core share its index */
+        cpu->package = topology->package_count;
+        for (j = 0; j < i; j++)
+        {
+            if (package_ids[j] == package_ids[i])
+            {
+                cpu->package = topology->cpus[j].package;
+                break;
+            }
+        }
+        if (cpu->package == topology->package_count)
+            topology->package_count++;
+
+        cpu->core = topology->core_count;
+        cpu->smt = 0;
+        for (j = 0; j < i; j++)
+        {
+            if (package_ids[j] == package_ids[i] && core_ids[j] == core_ids[i])
+            {
+                cpu->core = topology->cpus[j].core;
+                cpu->smt++;
+            }
+        }
+        if (cpu->core == topology->core_count)
+            topology->core_count++;
+        if (cpu->smt + 1 > topology->smt_width)
+            topology->smt_width = cpu->smt + 1;
+
+        if (ranks[i] < min_rank)
+            min_rank = ranks[i];
+        if (ranks[i] > max_rank)
+            max_rank = ranks[i];
+    }
+
+    /* On hybrid CPUs the cores with the highest rank (capacity / efficiency class) are the performance ones */
+    topology->performance_core_count = 0;
+    topology->efficiency_core_count = 0;
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        gd_topology_cpu_t* cpu = &topology->cpus[i];
+        if (min_rank == max_rank)
+            cpu->type = GD_CORE_TYPE_UNKNOWN;
+        else
+            cpu->type = ranks[i] == max_rank ? GD_CORE_TYPE_PERFORMANCE : GD_CORE_TYPE_EFFICIENCY;
+        if (cpu->smt == 0 && cpu->type == GD_CORE_TYPE_PERFORMANCE)
+            topology->performance_core_count++;
+        else if (cpu->smt == 0 && cpu->type == GD_CORE_TYPE_EFFICIENCY)
+            topology->efficiency_core_count++;
+    }
+}
+
+/* Assigns CPUs without a known node to a single node 0 */
+static void gd_internal_topology_single_node(gd_topology_t* topology)
+{
+    gd_numa_node_t* node = &topology->nodes[0];
+    unsigned int i;
+
+    gd_internal_memset(node, 0, sizeof(*node));
+    node->distances[0] = 10;
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        topology->cpus[i].node = 0;
+        node->cpus[topology->cpus[i].id / 64] |= (gd_u64_t)1 << (topology->cpus[i].id % 64);
+    }
+    node->cpu_count = topology->cpu_count;
+    topology->node_count = 1;
+}
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Sets the bits of a Linux CPU list, e.g. "0-3,8-11", in a mask */
+static void gd_internal_parse_cpu_mask(const char* list, gd_u64_t* mask, unsigned int max_cpus)
+{
+    while (*list >= '0' && *list <= '9')
+    {
+        const char* end;
+        gd_u64_t first = gd_internal_parse_u64(list, &end), last = first, cpu;
+        if (*end == '-')
+            last = gd_internal_parse_u64(end + 1, &end);
+        for (cpu = first; cpu <= last && cpu < max_cpus; cpu++)
+            mask[cpu / 64] |= (gd_u64_t)1 << (cpu % 64);
+        if (*end != ',')
+            break;
+        list = end + 1;
+    }
+}
+
+static int gd_internal_topology_probe_sysfs(gd_topology_t* topology)
+{
+    char buffer[4096], path[128];
+    gd_u64_t online[GD_CPU_MASK_WORDS], atom[GD_CPU_MASK_WORDS], nodes[(GD_TOPOLOGY_MAX_NODES + 63) / 64];
+    unsigned int package_ids[GD_TOPOLOGY_MAX_CPUS], core_ids[GD_TOPOLOGY_MAX_CPUS], ranks[GD_TOPOLOGY_MAX_CPUS];
+    unsigned int id, i, j;
+    int hybrid;
+
+    memset(online, 0, sizeof(online));
+    if (gd_internal_read_file("/sys/devices/system/cpu/online", buffer, sizeof(buffer)) <= 0)
+        return 0;
+    gd_internal_parse_cpu_mask(buffer, online, GD_TOPOLOGY_MAX_CPUS);
+
+    /* Intel hybrid CPUs list their E-cores as a separate PMU, everything else reports the capacity */
+    memset(atom, 0, sizeof(atom));
+    hybrid = gd_internal_read_file("/sys/devices/cpu_atom/cpus", buffer, sizeof(buffer)) > 0;
+    if (hybrid)
+        gd_internal_parse_cpu_mask(buffer, atom, GD_TOPOLOGY_MAX_CPUS);
+
+    for (id = 0; id < GD_TOPOLOGY_MAX_CPUS; id++)
+    {
+        gd_topology_cpu_t* cpu;
+        if (!GD_CPU_MASK_HAS(online, id))
+            continue;
+        i = topology->cpu_count;
+        cpu = gd_internal_topology_cpu(topology, id);
+
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu", id, "/topology/physical_package_id");
+        package_ids[i] = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : 0;
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu", id, "/topology/core_id");
+        core_ids[i] = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : id;
+        if (hybrid)
+        {
+            ranks[i] = GD_CPU_MASK_HAS(atom, id) ? 0 : 1;
+        }
+        else
+        {
+            gd_internal_make_path(path, sizeof(path), "/sys/devices/system/cpu/cpu", id, "/cpu_capacity");
+            ranks[i] = gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 ? (unsigned int)gd_internal_parse_u64(buffer, NULL) : 0;
+        }
+        cpu->node = 0;
+    }
+    if (topology->cpu_count == 0)
+        return 0;
+    gd_internal_topology_finish(topology, package_ids, core_ids, ranks);
+
+    memset(nodes, 0, sizeof(nodes));
+    if (gd_internal_read_file("/sys/devices/system/node/online", buffer, sizeof(buffer)) <= 0)
+    {
+        gd_internal_topology_single_node(topology);
+        return 1;
+    }
+    gd_internal_parse_cpu_mask(buffer, nodes, GD_TOPOLOGY_MAX_NODES);
+
+    topology->node_count = 0;
+    for (id = 0; id < GD_TOPOLOGY_MAX_NODES; id++)
+    {
+        gd_numa_node_t* node;
+        const char* cursor;
+
+        if (!GD_CPU_MASK_HAS(nodes, id))
+            continue;
+        node = &topology->nodes[topology->node_count++];
+        memset(node, 0, sizeof(*node));
+        node->id = id;
+
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/node/node", id, "/cpulist");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0)
+            gd_internal_parse_cpu_mask(buffer, node->cpus, GD_TOPOLOGY_MAX_CPUS);
+        for (i = 0; i < topology->cpu_count; i++)
+        {
+            if (GD_CPU_MASK_HAS(node->cpus, topology->cpus[i].id))
+            {
+                topology->cpus[i].node = id;
+                node->cpu_count++;
+            }
+        }
+
+        /* The distances are listed in the order of the online nodes */
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/node/node", id, "/distance");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0)
+        {
+            cursor = buffer;
+            for (j = 0; j < GD_TOPOLOGY_MAX_NODES && *cursor; j++)
+                node->distances[j] = (unsigned char)gd_internal_parse_u64(cursor, &cursor);
+        }
+
+        /* "Node 0 MemTotal:       16384 kB" */
+        gd_internal_make_path(path, sizeof(path), "/sys/devices/system/node/node", id, "/meminfo");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0 && (cursor = strstr(buffer, "MemTotal:")) != NULL)
+            node->memory = gd_internal_parse_u64(cursor + 9, NULL) * 1024;
+    }
+    if (topology->node_count == 0)
+        gd_internal_topology_single_node(topology);
+    return 1;
+}
+#endif
+
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+static int gd_internal_topology_probe_windows(gd_topology_t* topology)
+{
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* buffer;
+    unsigned int package_ids[GD_TOPOLOGY_MAX_CPUS], core_ids[GD_TOPOLOGY_MAX_CPUS], ranks[GD_TOPOLOGY_MAX_CPUS];
+    unsigned int core = 0, package = 0, i;
+    DWORD length = 0, offset;
+
+    GetLogicalProcessorInformationEx(RelationAll, NULL, &length);
+    buffer = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)malloc(length);
+    if (buffer == NULL)
+        return 0;
+    if (!GetLogicalProcessorInformationEx(RelationAll, buffer, &length))
+    {
+        free(buffer);
+        return 0;
+    }
+
+    /* Cores come before packages and nodes, so every CPU already exists when those are handled */
+    for (offset = 0; offset < length; offset += ((SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset))->Size)
+    {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* entry = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset);
+        if (entry->Relationship == RelationProcessorCore)
+        {
+            const GROUP_AFFINITY* group = &entry->Processor.GroupMask[0];
+            for (i = 0; i < sizeof(KAFFINITY) * 8; i++)
+            {
+                gd_topology_cpu_t* cpu;
+                if (!((group->Mask >> i) & 1))
+                    continue;
+                cpu = gd_internal_topology_cpu(topology, group->Group * 64 + i);
+                if (cpu == NULL)
+                    continue;
+                core_ids[cpu - topology->cpus] = core;
+                package_ids[cpu - topology->cpus] = 0;
+                ranks[cpu - topology->cpus] = entry->Processor.EfficiencyClass;
+            }
+            core++;
+        }
+    }
+    for (offset = 0; offset < length; offset += ((SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset))->Size)
+    {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* entry = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset);
+        if (entry->Relationship == RelationProcessorPackage)
+        {
+            WORD group;
+            for (group = 0; group < entry->Processor.GroupCount; group++)
+            {
+                for (i = 0; i < topology->cpu_count; i++)
+                {
+                    unsigned int id = topology->cpus[i].id;
+                    if (id / 64 == entry->Processor.GroupMask[group].Group && ((entry->Processor.GroupMask[group].Mask >> (id % 64)) & 1))
+                        package_ids[i] = package;
+                }
+            }
+            package++;
+        }
+    }
+    gd_internal_topology_finish(topology, package_ids, core_ids, ranks);
+
+    topology->node_count = 0;
+    for (offset = 0; offset < length; offset += ((SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset))->Size)
+    {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* entry = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)((char*)buffer + offset);
+        gd_numa_node_t* node;
+        if (entry->Relationship != RelationNumaNode || topology->node_count >= GD_TOPOLOGY_MAX_NODES)
+            continue;
+        node = &topology->nodes[topology->node_count++];
+        memset(node, 0, sizeof(*node));
+        node->id = entry->NumaNode.NodeNumber;
+        for (i = 0; i < topology->cpu_count; i++)
+        {
+            unsigned int id = topology->cpus[i].id;
+            if (id / 64 == entry->NumaNode.GroupMask.Group && ((entry->NumaNode.GroupMask.Mask >> (id % 64)) & 1))
+            {
+                topology->cpus[i].node = node->id;
+                node->cpus[id / 64] |= (gd_u64_t)1 << (id % 64);
+                node->cpu_count++;
+            }
+        }
+    }
+    free(buffer);
+
+    if (topology->node_count == 0)
+        gd_internal_topology_single_node(topology);
+    return topology->cpu_count != 0;
+}
+#endif
+
+/* Fallback for systems which only report counts, the CPUs are assumed to be numbered core by core */
+static int gd_internal_topology_probe_counts(gd_topology_t* topology)
+{
+    unsigned int package_ids[GD_TOPOLOGY_MAX_CPUS], core_ids[GD_TOPOLOGY_MAX_CPUS], ranks[GD_TOPOLOGY_MAX_CPUS];
+    unsigned int cpus = 0, cores = 0, packages = 1, i;
+
+#if GD_INTERNAL_HAS_SYSCTLBYNAME
+    #ifdef GD_OS_GENERIC_APPLE
+    cpus = (unsigned int)gd_internal_sysctl_u64("hw.logicalcpu");
+    cores = (unsigned int)gd_internal_sysctl_u64("hw.physicalcpu");
+    packages = (unsigned int)gd_internal_sysctl_u64("hw.packages");
+    #else
+    cpus = (unsigned int)gd_internal_sysctl_u64("kern.smp.cpus");
+    cores = (unsigned int)gd_internal_sysctl_u64("kern.smp.cores");
+    #endif
+#endif
+#if GD_INTERNAL_HAS_POSIX && defined(_SC_NPROCESSORS_ONLN)
+    if (cpus == 0)
+        cpus = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cpus == 0)
+        return 0;
+    if (cpus > GD_TOPOLOGY_MAX_CPUS)
+        cpus = GD_TOPOLOGY_MAX_CPUS;
+    if (cores == 0 || cores > cpus)
+        cores = cpus;
+    if (packages == 0)
+        packages = 1;
+
+    for (i = 0; i < cpus; i++)
+    {
+        gd_internal_topology_cpu(topology, i);
+        core_ids[i] = i / (cpus / cores);
+        package_ids[i] = core_ids[i] / ((cores + packages - 1) / packages);
+        ranks[i] = 0;
+    }
+    gd_internal_topology_finish(topology, package_ids, core_ids, ranks);
+    gd_internal_topology_single_node(topology);
+
+#if GD_INTERNAL_HAS_SYSCTLBYNAME && defined(GD_OS_GENERIC_APPLE)
+    /* Apple does not say which CPU is which, only how many cores there are of every type */
+    if (gd_internal_sysctl_u64("hw.nperflevels") > 1)
+    {
+        topology->performance_core_count = (unsigned int)gd_internal_sysctl_u64("hw.perflevel0.physicalcpu");
+        topology->efficiency_core_count = (unsigned int)gd_internal_sysctl_u64("hw.perflevel1.physicalcpu");
+    }
+#endif
+    return 1;
+}
+
+GD_API int gd_topology_probe(gd_topology_t* topology)
+{
+    int found = 0;
+
+    gd_internal_memset(topology, 0, sizeof(*topology));
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    found = gd_internal_topology_probe_sysfs(topology);
+#elif defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    found = gd_internal_topology_probe_windows(topology);
+#endif
+    if (!found)
+    {
+        gd_internal_memset(topology, 0, sizeof(*topology));
+        found = gd_internal_topology_probe_counts(topology);
+    }
+    return found;
+}
+
+static gd_topology_t gd_internal_topology;
+static gd_internal_once_t gd_internal_topology_once = 0;
+
+GD_API const gd_topology_t* gd_topology(void)
+{
+    if (gd_internal_once_begin(&gd_internal_topology_once))
+    {
+        gd_topology_probe(&gd_internal_topology);
+        gd_internal_once_end(&gd_internal_topology_once);
+    }
+    return &gd_internal_topology;
+}
+
+/* Pins the calling thread to the CPUs in a mask indexed by the OS CPU numbers */
+static int gd_internal_thread_pin_mask(const gd_u64_t* mask)
+{
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    /* The raw syscall does not need _GNU_SOURCE, the kernel takes the mask as an array of longs */
+    unsigned long words[GD_TOPOLOGY_MAX_CPUS / (sizeof(unsigned long) * 8) + 1];
+    unsigned int cpu;
+
+    memset(words, 0, sizeof(words));
+    for (cpu = 0; cpu < GD_TOPOLOGY_MAX_CPUS; cpu++)
+    {
+        if (GD_CPU_MASK_HAS(mask, cpu))
+            words[cpu / (sizeof(unsigned long) * 8)] |= 1ul << (cpu % (sizeof(unsigned long) * 8));
+    }
+    return syscall(SYS_sched_setaffinity, 0, sizeof(words), words) == 0;
+#elif defined(GD_OS_FREEBSD) && !GD_NO_EXTERNAL_INCLUDES
+    cpuset_t set;
+    unsigned int cpu;
+
+    CPU_ZERO(&set);
+    for (cpu = 0; cpu < GD_TOPOLOGY_MAX_CPUS && cpu < CPU_SETSIZE; cpu++)
+    {
+        if (GD_CPU_MASK_HAS(mask, cpu))
+            CPU_SET(cpu, &set);
+    }
+    return cpuset_setaffinity(CPU_LEVEL_WHICH, CPU_WHICH_TID, -1, sizeof(set), &set) == 0;
+#elif defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    /* A thread can only run on the CPUs of a single processor group, the first one in the mask is used */
+    GROUP_AFFINITY affinity;
+    unsigned int word;
+
+    for (word = 0; word < GD_CPU_MASK_WORDS; word++)
+    {
+        if (mask[word] == 0)
+            continue;
+        memset(&affinity, 0, sizeof(affinity));
+        affinity.Group = (WORD)word;
+        affinity.Mask = (KAFFINITY)mask[word];
+        return SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL) != 0;
+    }
+    return 0;
+#else
+    (void)mask;
+    return 0;
+#endif
+}
+
+GD_API int gd_thread_pin_cpu(unsigned int cpu)
+{
+    gd_u64_t mask[GD_CPU_MASK_WORDS];
+
+    if (cpu >= GD_TOPOLOGY_MAX_CPUS)
+        return 0;
+    gd_internal_memset(mask, 0, sizeof(mask));
+    mask[cpu / 64] |= (gd_u64_t)1 << (cpu % 64);
+    return gd_internal_thread_pin_mask(mask);
+}
+
+GD_API int gd_thread_pin_node(unsigned int node)
+{
+    const gd_topology_t* topology = gd_topology();
+    unsigned int i;
+
+    for (i = 0; i < topology->node_count; i++)
+    {
+        if (topology->nodes[i].id == node)
+            return gd_internal_thread_pin_mask(topology->nodes[i].cpus);
+    }
+    return 0;
+}
+
+/* Pages */
+
+#if !GD_NO_EXTERNAL_INCLUDES
+static void gd_internal_huge_page_add(gd_page_info_t* info, gd_u64_t size, gd_u64_t total, gd_u64_t free)
+{
+    unsigned int i, position;
+
+    if (info->huge_page_count >= GD_HUGE_PAGE_MAX_COUNT || size <= info->page_size)
+        return;
+    for (i = 0; i < info->huge_page_count; i++)
+    {
+        if (info->huge_pages[i].size == size)
+            return;
+    }
+
+    position = info->huge_page_count;
+    while (position > 0 && info->huge_pages[position - 1].size > size)
+    {
+        info->huge_pages[position] = info->huge_pages[position - 1];
+        position--;
+    }
+    info->huge_pages[position].size = size;
+    info->huge_pages[position].total = total;
+    info->huge_pages[position].free = free;
+    info->huge_page_count++;
+}
+#endif
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+static void gd_internal_page_probe_sysfs(gd_page_info_t* info)
+{
+    char buffer[128], path[128];
+    DIR* directory;
+    struct dirent* entry;
+
+    /* The selected mode is in brackets, e.g. "always [madvise] never" */
+    if (gd_internal_read_file("/sys/kernel/mm/transparent_hugepage/enabled", buffer, sizeof(buffer)) > 0)
+    {
+        if (strstr(buffer, "[always]"))
+            info->thp_mode = GD_THP_MODE_ALWAYS;
+        else if (strstr(buffer, "[madvise]"))
+            info->thp_mode = GD_THP_MODE_MADVISE;
+        else if (strstr(buffer, "[never]"))
+            info->thp_mode = GD_THP_MODE_NEVER;
+    }
+    if (gd_internal_read_file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", buffer, sizeof(buffer)) > 0)
+        info->thp_size = gd_internal_parse_u64(buffer, NULL);
+
+    /* One directory per supported size, e.g. hugepages-2048kB */
+    directory = opendir("/sys/kernel/mm/hugepages");
+    if (!directory)
+        return;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        gd_u64_t size_kb, total = 0, free = 0;
+
+        if (strncmp(entry->d_name, "hugepages-", 10) != 0)
+            continue;
+        size_kb = gd_internal_parse_u64(entry->d_name + 10, NULL);
+        if (size_kb == 0 || size_kb > (gd_u64_t)0xFFFFFFFFu)
+            continue;
+
+        gd_internal_make_path(path, sizeof(path), "/sys/kernel/mm/hugepages/hugepages-", (unsigned int)size_kb, "kB/nr_hugepages");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0)
+            total = gd_internal_parse_u64(buffer, NULL);
+        gd_internal_make_path(path, sizeof(path), "/sys/kernel/mm/hugepages/hugepages-", (unsigned int)size_kb, "kB/free_hugepages");
+        if (gd_internal_read_file(path, buffer, sizeof(buffer)) > 0)
+            free = gd_internal_parse_u64(buffer, NULL);
+        gd_internal_huge_page_add(info, size_kb << 10, total, free);
+    }
+    closedir(directory);
+}
+#endif
+
+#if defined(GD_OS_FREEBSD) && !GD_NO_EXTERNAL_INCLUDES
+static void gd_internal_page_probe_freebsd(gd_page_info_t* info)
+{
+    size_t sizes[GD_HUGE_PAGE_MAX_COUNT];
+    int count, i;
+
+    /* Superpages are promoted transparently when vm.pmap.pg_ps_enabled is set */
+    count = getpagesizes(sizes, GD_HUGE_PAGE_MAX_COUNT);
+    for (i = 1; i < count; i++)
+        gd_internal_huge_page_add(info, sizes[i], 0, 0);
+    if (count > 1)
+    {
+        info->thp_mode = gd_internal_sysctl_flag("vm.pmap.pg_ps_enabled") ? GD_THP_MODE_ALWAYS : GD_THP_MODE_NEVER;
+        info->thp_size = sizes[1];
+    }
+}
+#endif
+
+GD_API int gd_page_info_probe(gd_page_info_t* info)
+{
+    int found = 0;
+
+    gd_internal_memset(info, 0, sizeof(*info));
+    info->page_size = GD_PAGE_SIZE_DEFAULT;
+
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    {
+        SYSTEM_INFO system;
+        SIZE_T large_page;
+
+        GetSystemInfo(&system);
+        if (system.dwPageSize)
+        {
+            info->page_size = system.dwPageSize;
+            info->allocation_granularity = system.dwAllocationGranularity;
+            found = 1;
+        }
+        /* NOTE: Using them needs the SeLockMemoryPrivilege */
+        large_page = GetLargePageMinimum();
+        if (large_page)
+            gd_internal_huge_page_add(info, large_page, 0, 0);
+    }
+#elif GD_INTERNAL_HAS_POSIX
+    {
+        long size = sysconf(_SC_PAGESIZE);
+        if (size > 0)
+        {
+            info->page_size = (gd_u64_t)size;
+            found = 1;
+        }
+    }
+    #if defined(GD_OS_LINUX)
+    gd_internal_page_probe_sysfs(info);
+    #elif defined(GD_OS_FREEBSD)
+    gd_internal_page_probe_freebsd(info);
+    #endif
+#endif
+
+    if (info->allocation_granularity == 0)
+        info->allocation_granularity = info->page_size;
+    return found;
+}
+
+static gd_page_info_t gd_internal_page_info;
+static gd_internal_once_t gd_internal_page_info_once = 0;
+
+GD_API const gd_page_info_t* gd_page_info(void)
+{
+    if (gd_internal_once_begin(&gd_internal_page_info_once))
+    {
+        gd_page_info_probe(&gd_internal_page_info);
+        gd_internal_once_end(&gd_internal_page_info_once);
+    }
+    return &gd_internal_page_info;
+}
+
+GD_API gd_u64_t gd_page_size(void)
+{
+    return gd_page_info()->page_size;
+}
+
+/* Resource limits */
+
+/* Keeps the lower of two limits, where 0 means no limit */
+GD_INTERNAL_HELPER gd_u64_t gd_internal_min_limit(gd_u64_t a, gd_u64_t b)
+{
+    if (a == 0)
+        return b;
+    return (b == 0 || a < b) ? a : b;
+}
+
+#if !GD_NO_EXTERNAL_INCLUDES
+/* Keeps the quota that allows the fewest CPUs */
+static void gd_internal_limits_add_quota(gd_limits_t* limits, gd_u64_t quota, gd_u64_t period)
+{
+    if (quota == 0 || period == 0)
+        return;
+    if (limits->cpu_period == 0 || quota * limits->cpu_period < limits->cpu_quota * period)
+    {
+        limits->cpu_quota = quota;
+        limits->cpu_period = period;
+    }
+}
+#endif
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Cuts the next field off a line at a separator or the end of the line */
+static char* gd_internal_next_field(char** cursor, char separator)
+{
+    char* field = *cursor;
+    char* end = field;
+
+    while (*end && *end != separator && *end != '\n')
+        end++;
+    *cursor = *end ? end + 1 : end;
+    *end = '\0';
+    return field;
+}
+
+/* Checks if a comma separated list, e.g. "rw,cpu,cpuacct", contains a token */
+static int gd_internal_has_token(const char* list, const char* token)
+{
+    size_t length = strlen(token);
+
+    while (list)
+    {
+        if (strncmp(list, token, length) == 0 && (list[length] == ',' || list[length] == '\0'))
+            return 1;
+        list = strchr(list, ',');
+        if (list)
+            list++;
+    }
+    return 0;
+}
+
+/*
+ * Finds the directory of the cgroup of the process for a v1 controller, or the
+ * v2 one if controller is NULL. Returns the length of the mount point of the
+ * hierarchy in path, or 0 if the process is not in such a cgroup.
+ */
+static int gd_internal_cgroup_path(const char* controller, char* path, size_t size)
+{
+    char line[4096], cgroup[1024];
+    char *cursor, *id, *field, *root, *mount, *type, *options;
+    const char* relative;
+    size_t root_length;
+    int found = 0, mount_length = 0;
+    FILE* file;
+
+    /* "4:cpu,cpuacct:/docker/abc" for v1, "0::/user.slice" for v2 */
+    file = fopen("/proc/self/cgroup", "r");
+    if (!file)
+        return 0;
+    while (!found && fgets(line, sizeof(line), file))
+    {
+        cursor = line;
+        id = gd_internal_next_field(&cursor, ':');
+        field = gd_internal_next_field(&cursor, ':');
+        if (controller ? gd_internal_has_token(field, controller) : (strcmp(id, "0") == 0 && *field == '\0'))
+        {
+            field = gd_internal_next_field(&cursor, '\n');
+            if (strlen(field) < sizeof(cgroup))
+            {
+                strcpy(cgroup, field);
+                found = 1;
+            }
+        }
+    }
+    fclose(file);
+    if (!found)
+        return 0;
+
+    /* "30 23 0:26 / /sys/fs/cgroup/cpu,cpuacct rw,nosuid - cgroup cgroup rw,cpu,cpuacct" */
+    file = fopen("/proc/self/mountinfo", "r");
+    if (!file)
+        return 0;
+    while (!mount_length && fgets(line, sizeof(line), file))
+    {
+        cursor = line;
+        gd_internal_next_field(&cursor, ' ');
+        gd_internal_next_field(&cursor, ' ');
+        gd_internal_next_field(&cursor, ' ');
+        root = gd_internal_next_field(&cursor, ' ');
+        mount = gd_internal_next_field(&cursor, ' ');
+        cursor = strstr(cursor, " - ");
+        if (!cursor)
+            continue;
+        cursor += 3;
+        type = gd_internal_next_field(&cursor, ' ');
+        gd_internal_next_field(&cursor, ' ');
+        options = gd_internal_next_field(&cursor, ' ');
+        if (controller ? (strcmp(type, "cgroup") != 0 || !gd_internal_has_token(options, controller)) : strcmp(type, "cgroup2") != 0)
+            continue;
+
+        /* Without a cgroup namespace a container mounts its own cgroup, so the path is relative to the root of the mount */
+        relative = cgroup;
+        root_length = strlen(root);
+        if (strcmp(root, "/") != 0)
+        {
+            if (strncmp(cgroup, root, root_length) == 0 && (cgroup[root_length] == '/' || cgroup[root_length] == '\0'))
+                relative = cgroup + root_length;
+            else
+                relative = "";
+        }
+        if (strcmp(relative, "/") == 0)
+            relative = "";
+        if (strlen(mount) + strlen(relative) < size)
+        {
+            strcpy(path, mount);
+            strcat(path, relative);
+            mount_length = (int)strlen(mount);
+        }
+    }
+    fclose(file);
+    return mount_length;
+}
+
+/* Reads a file in a cgroup directory, returns its length or -1 */
+static int gd_internal_cgroup_read(const char* directory, const char* name, char* buffer, int size)
+{
+    char path[1280];
+
+    if (strlen(directory) + 1 + strlen(name) >= sizeof(path))
+        return -1;
+    strcpy(path, directory);
+    strcat(path, "/");
+    strcat(path, name);
+    return gd_internal_read_file(path, buffer, size);
+}
+
+/* Applies the limits of a cgroup and of its ancestors up to the mount point, returns 0 if none of the files exist */
+static int gd_internal_limits_probe_cgroup(gd_limits_t* limits, char* path, int mount_length, unsigned int version)
+{
+    char buffer[256];
+    const char* cursor;
+    gd_u64_t quota, value;
+    char* slash;
+    int found = 0;
+
+    for (;;)
+    {
+        if (version == 2)
+        {
+            /* "max 100000" or "400000 100000" */
+            if (gd_internal_cgroup_read(path, "cpu.max", buffer, sizeof(buffer)) > 0)
+            {
+                found = 1;
+                quota = gd_internal_parse_u64(buffer, &cursor);
+                gd_internal_limits_add_quota(limits, quota, gd_internal_parse_u64(cursor, NULL));
+            }
+            /* "max" parses as 0, which is no limit */
+            if (gd_internal_cgroup_read(path, "memory.max", buffer, sizeof(buffer)) > 0)
+            {
+                found = 1;
+                limits->memory_max = gd_internal_min_limit(limits->memory_max, gd_internal_parse_u64(buffer, NULL));
+            }
+            if (gd_internal_cgroup_read(path, "memory.high", buffer, sizeof(buffer)) > 0)
+                limits->memory_high = gd_internal_min_limit(limits->memory_high, gd_internal_parse_u64(buffer, NULL));
+        }
+        else
+        {
+            /* The quota is -1 without a limit */
+            if (gd_internal_cgroup_read(path, "cpu.cfs_quota_us", buffer, sizeof(buffer)) > 0)
+            {
+                found = 1;
+                if (buffer[0] != '-')
+                {
+                    quota = gd_internal_parse_u64(buffer, NULL);
+                    if (gd_internal_cgroup_read(path, "cpu.cfs_period_us", buffer, sizeof(buffer)) > 0)
+                        gd_internal_limits_add_quota(limits, quota, gd_internal_parse_u64(buffer, NULL));
+                }
+            }
+            /* Without a limit it is the largest long rounded down to a page */
+            if (gd_internal_cgroup_read(path, "memory.limit_in_bytes", buffer, sizeof(buffer)) > 0)
+            {
+                found = 1;
+                value = gd_internal_parse_u64(buffer, NULL);
+                if (value < ((gd_u64_t)1 << 62))
+                    limits->memory_max = gd_internal_min_limit(limits->memory_max, value);
+            }
+        }
+
+        slash = strrchr(path, '/');
+        if (!slash || slash - path < mount_length)
+            break;
+        *slash = '\0';
+    }
+    return found;
+}
+
+static void gd_internal_limits_probe_linux(gd_limits_t* limits)
+{
+    unsigned long words[GD_TOPOLOGY_MAX_CPUS / (sizeof(unsigned long) * 8) + 1];
+    char path[1024], buffer[4096];
+    unsigned int cpuset = 0, i;
+    long result;
+    int mount_length;
+
+    /* The raw syscall does not need _GNU_SOURCE, it returns the size of the mask it wrote */
+    memset(words, 0, sizeof(words));
+    result = syscall(SYS_sched_getaffinity, 0, sizeof(words), words);
+    if (result > 0)
+    {
+        for (i = 0; i < (unsigned int)result / sizeof(unsigned long); i++)
+            limits->cpu_count += (unsigned int)gd_popcount64(words[i]);
+    }
+
+    /* cgroup v2, in the hybrid layout the controllers are still in v1 and these files are missing */
+    mount_length = gd_internal_cgroup_path(NULL, path, sizeof(path));
+    if (mount_length && gd_internal_limits_probe_cgroup(limits, path, mount_length, 2))
+    {
+        limits->cgroup_version = 2;
+        gd_internal_cgroup_path(NULL, path, sizeof(path));
+        if (gd_internal_cgroup_read(path, "cpuset.cpus.effective", buffer, sizeof(buffer)) > 0)
+            cpuset = gd_internal_count_cpu_list(buffer);
+    }
+    else
+    {
+        mount_length = gd_internal_cgroup_path("cpu", path, sizeof(path));
+        if (mount_length && gd_internal_limits_probe_cgroup(limits, path, mount_length, 1))
+            limits->cgroup_version = 1;
+        mount_length = gd_internal_cgroup_path("memory", path, sizeof(path));
+        if (mount_length && gd_internal_limits_probe_cgroup(limits, path, mount_length, 1))
+            limits->cgroup_version = 1;
+        if (gd_internal_cgroup_path("cpuset", path, sizeof(path))
+            && (gd_internal_cgroup_read(path, "cpuset.effective_cpus", buffer, sizeof(buffer)) > 0
+                || gd_internal_cgroup_read(path, "cpuset.cpus", buffer, sizeof(buffer)) > 0))
+            cpuset = gd_internal_count_cpu_list(buffer);
+    }
+
+    /* The affinity is already limited to the cpuset, unless it could not be read */
+    if (cpuset && (limits->cpu_count == 0 || cpuset < limits->cpu_count))
+        limits->cpu_count = cpuset;
+}
+#endif
+
+GD_API int gd_limits_probe(gd_limits_t* limits)
+{
+    gd_u64_t cpus;
+
+    gd_internal_memset(limits, 0, sizeof(*limits));
+
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    {
+        MEMORYSTATUSEX memory;
+        DWORD_PTR process_mask, system_mask;
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION job;
+        JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rate;
+
+        memory.dwLength = sizeof(memory);
+        if (GlobalMemoryStatusEx(&memory))
+            limits->memory_total = memory.ullTotalPhys;
+        /* NOTE: Both masks are 0 when the process runs in more than one processor group */
+        if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+            limits->cpu_count = (unsigned int)gd_popcount64((gd_u64_t)process_mask);
+
+        /* Containers and other sandboxes put the process in a job, NULL queries the job of the process */
+        if (QueryInformationJobObject(NULL, JobObjectExtendedLimitInformation, &job, sizeof(job), NULL))
+        {
+            if (job.BasicLimitInformation.LimitFlags & JOB_OBJECT_LIMIT_PROCESS_MEMORY)
+                limits->memory_max = gd_internal_min_limit(limits->memory_max, job.ProcessMemoryLimit);
+            if (job.BasicLimitInformation.LimitFlags & JOB_OBJECT_LIMIT_JOB_MEMORY)
+                limits->memory_max = gd_internal_min_limit(limits->memory_max, job.JobMemoryLimit);
+        }
+        /* The hard cap is in 1/100 of a percent of all CPUs of the machine */
+        if (QueryInformationJobObject(NULL, JobObjectCpuRateControlInformation, &rate, sizeof(rate), NULL)
+            && (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) && (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP))
+            gd_internal_limits_add_quota(limits, (gd_u64_t)rate.CpuRate * gd_topology()->cpu_count, 10000);
+    }
+#elif GD_INTERNAL_HAS_POSIX
+    {
+    #if defined(_SC_PHYS_PAGES)
+        long pages = sysconf(_SC_PHYS_PAGES);
+        if (pages > 0)
+            limits->memory_total = (gd_u64_t)pages * gd_page_size();
+    #endif
+    #if defined(GD_OS_LINUX)
+        gd_internal_limits_probe_linux(limits);
+    #endif
+    }
+#endif
+
+    cpus = gd_topology()->cpu_count;
+    if (limits->cpu_count == 0 || (cpus && limits->cpu_count > cpus))
+        limits->cpu_count = (unsigned int)cpus;
+
+    /* A quota of 1.5 CPUs still lets two threads make progress */
+    limits->parallelism = limits->cpu_count ? limits->cpu_count : 1;
+    if (limits->cpu_period && (limits->cpu_quota + limits->cpu_period - 1) / limits->cpu_period < limits->parallelism)
+        limits->parallelism = (unsigned int)((limits->cpu_quota + limits->cpu_period - 1) / limits->cpu_period);
+    if (limits->parallelism == 0)
+        limits->parallelism = 1;
+
+    limits->memory_budget = gd_internal_min_limit(gd_internal_min_limit(limits->memory_total, limits->memory_max), limits->memory_high);
+    return limits->cpu_count != 0 || limits->memory_total != 0;
+}
+
+static gd_limits_t gd_internal_limits;
+static gd_internal_once_t gd_internal_limits_once = 0;
+
+GD_API const gd_limits_t* gd_limits(void)
+{
+    if (gd_internal_once_begin(&gd_internal_limits_once))
+    {
+        gd_limits_probe(&gd_internal_limits);
+        gd_internal_once_end(&gd_internal_limits_once);
+    }
+    return &gd_internal_limits;
+}
+
+GD_API unsigned int gd_parallelism(void)
+{
+    return gd_limits()->parallelism;
+}
+
+GD_API gd_u64_t gd_memory_budget(void)
+{
+    return gd_limits()->memory_budget;
+}
+
+/* Virtualization */
+
+typedef struct gd_internal_hypervisor_name
+{
+    const char* name;
+    gd_hypervisor_t hypervisor;
+} gd_internal_hypervisor_name_t;
+
+/* Looks a name up in a table, returns GD_HYPERVISOR_NONE if none of the entries occur in it */
+static gd_hypervisor_t gd_internal_hypervisor_find(const gd_internal_hypervisor_name_t* table, unsigned int count, const char* name)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (gd_internal_strstr(name, table[i].name))
+            return table[i].hypervisor;
+    }
+    return GD_HYPERVISOR_NONE;
+}
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+static const gd_internal_hypervisor_name_t gd_internal_cpuid_hypervisors[] = {
+    { "KVMKVMKVM", GD_HYPERVISOR_KVM },
+    { "Linux KVM Hv", GD_HYPERVISOR_KVM },
+    { "XenVMMXenVMM", GD_HYPERVISOR_XEN },
+    { "Microsoft Hv", GD_HYPERVISOR_HYPERV },
+    { "VMwareVMware", GD_HYPERVISOR_VMWARE },
+    { "VBoxVBoxVBox", GD_HYPERVISOR_VIRTUALBOX },
+    { "TCGTCGTCGTCG", GD_HYPERVISOR_QEMU },
+    { " lrpepyh  vr", GD_HYPERVISOR_PARALLELS },
+    { "bhyve bhyve ", GD_HYPERVISOR_BHYVE },
+    { "ACRNACRNACRN", GD_HYPERVISOR_ACRN },
+    { "VirtualApple", GD_HYPERVISOR_APPLE }
+};
+
+static void gd_internal_virt_probe_cpuid(gd_virt_info_t* info)
+{
+    unsigned int regs[4], base, found_base = 0;
+    char vendor[13];
+    gd_hypervisor_t hypervisor;
+
+    gd_internal_cpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000001u)
+    {
+        gd_internal_cpuid(0x80000001u, 0, regs);
+        if (regs[2] & (1u << 2))
+            info->flags |= GD_VIRT_NESTED;
+    }
+    gd_internal_cpuid(1, 0, regs);
+    if (regs[2] & (1u << 5))
+        info->flags |= GD_VIRT_NESTED;
+    if (!(regs[2] & (1u << 31)))
+    {
+        info->flags &= ~GD_VIRT_NESTED;
+        return;
+    }
+    info->hypervisor = GD_HYPERVISOR_UNKNOWN;
+
+    /*
+     * Hypervisors that emulate Hyper-V for Windows guests (KVM, Xen) report it at
+     * 0x40000000 and themselves at a later base, so the last one found wins
+     */
+    for (base = 0x40000000u; base < 0x40010000u; base += 0x100)
+    {
+        gd_internal_cpuid(base, 0, regs);
+        if (regs[0] < base || regs[0] >= base + 0x100)
+            continue;
+        gd_internal_memcpy(vendor, &regs[1], 4);
+        gd_internal_memcpy(vendor + 4, &regs[2], 4);
+        gd_internal_memcpy(vendor + 8, &regs[3], 4);
+        vendor[12] = '\0';
+        hypervisor = gd_internal_hypervisor_find(gd_internal_cpuid_hypervisors, sizeof(gd_internal_cpuid_hypervisors) / sizeof(gd_internal_cpuid_hypervisors[0]), vendor);
+        if (hypervisor == GD_HYPERVISOR_NONE)
+            continue;
+        if (found_base == 0 || info->hypervisor == GD_HYPERVISOR_HYPERV)
+        {
+            info->hypervisor = hypervisor;
+            gd_internal_copy_string(info->vendor, sizeof(info->vendor), vendor);
+            found_base = base;
+        }
+    }
+
+    switch (info->hypervisor)
+    {
+    case GD_HYPERVISOR_KVM:
+        /* KVM_FEATURE_CLOCKSOURCE / CLOCKSOURCE2 / CLOCKSOURCE_STABLE_BIT in eax, KVM_HINTS_REALTIME in edx */
+        gd_internal_cpuid(found_base + 1, 0, regs);
+        if (regs[0] & ((1u << 0) | (1u << 3)))
+            info->flags |= GD_VIRT_PV_CLOCK;
+        if ((regs[0] & (1u << 24)) && gd_cpu_has(GD_CPU_FEATURE_INVARIANT_TSC))
+            info->flags |= GD_VIRT_TSC_RELIABLE;
+        if (regs[3] & (1u << 0))
+            info->flags |= GD_VIRT_DEDICATED_CPUS;
+        break;
+    case GD_HYPERVISOR_HYPERV:
+        /* The partition privileges: AccessPartitionReferenceTsc in eax, CreatePartitions (only the root partition) in ebx */
+        gd_internal_cpuid(0x40000003u, 0, regs);
+        if (regs[0] & (1u << 9))
+            info->flags |= GD_VIRT_PV_CLOCK;
+        if (regs[1] & (1u << 0))
+            info->flags |= GD_VIRT_HOST;
+        break;
+    case GD_HYPERVISOR_XEN:
+        info->flags |= GD_VIRT_PV_CLOCK;
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Matched against the DMI vendor and product name, for architectures without a hypervisor cpuid leaf */
+static const gd_internal_hypervisor_name_t gd_internal_dmi_hypervisors[] = {
+    { "KVM", GD_HYPERVISOR_KVM },
+    { "Google Compute Engine", GD_HYPERVISOR_KVM },
+    { "QEMU", GD_HYPERVISOR_QEMU },
+    { "VMware", GD_HYPERVISOR_VMWARE },
+    { "VirtualBox", GD_HYPERVISOR_VIRTUALBOX },
+    { "innotek GmbH", GD_HYPERVISOR_VIRTUALBOX },
+    { "Xen", GD_HYPERVISOR_XEN },
+    { "Virtual Machine", GD_HYPERVISOR_HYPERV },
+    { "Parallels", GD_HYPERVISOR_PARALLELS },
+    { "BHYVE", GD_HYPERVISOR_BHYVE },
+    { "Apple Virtualization", GD_HYPERVISOR_APPLE }
+};
+
+static void gd_internal_virt_probe_linux(gd_virt_info_t* info)
+{
+    static const char* const containers[] = { "docker", "kubepods", "containerd", "libpod", "lxc" };
+    char buffer[4096], vendor[64];
+    int has_dmi;
+    unsigned int i;
+
+    /* Xen, including paravirtualized guests, and the host (dom0) */
+    if (gd_internal_read_file("/sys/hypervisor/type", buffer, sizeof(buffer)) > 0 && strcmp(buffer, "xen") == 0)
+    {
+        if (info->hypervisor <= GD_HYPERVISOR_UNKNOWN)
+            info->hypervisor = GD_HYPERVISOR_XEN;
+        info->flags |= GD_VIRT_PV_CLOCK;
+        if (gd_internal_read_file("/proc/xen/capabilities", buffer, sizeof(buffer)) > 0 && strstr(buffer, "control_d"))
+            info->flags |= GD_VIRT_HOST;
+    }
+
+    /* The device tree of ARM and RISC-V guests, e.g. "xen,xen" for Xen and "linux,dummy-virt" for the QEMU virt machine */
+    if (info->hypervisor <= GD_HYPERVISOR_UNKNOWN && gd_internal_read_file("/proc/device-tree/hypervisor/compatible", buffer, sizeof(buffer)) > 0)
+        info->hypervisor = strstr(buffer, "xen") ? GD_HYPERVISOR_XEN : GD_HYPERVISOR_UNKNOWN;
+    if (info->hypervisor == GD_HYPERVISOR_NONE && gd_internal_read_file("/proc/device-tree/compatible", buffer, sizeof(buffer)) > 0
+        && strcmp(buffer, "linux,dummy-virt") == 0)
+        info->hypervisor = GD_HYPERVISOR_QEMU;
+
+    has_dmi = gd_internal_read_file("/sys/class/dmi/id/sys_vendor", vendor, sizeof(vendor)) >= 0;
+    if (!has_dmi)
+        vendor[0] = '\0';
+    if (gd_internal_read_file("/sys/class/dmi/id/product_name", buffer, sizeof(buffer)) > 0)
+        gd_internal_copy_string(info->product, sizeof(info->product), buffer);
+    if (info->hypervisor <= GD_HYPERVISOR_UNKNOWN)
+    {
+        gd_hypervisor_t hypervisor = gd_internal_hypervisor_find(gd_internal_dmi_hypervisors, sizeof(gd_internal_dmi_hypervisors) / sizeof(gd_internal_dmi_hypervisors[0]), vendor);
+        if (hypervisor == GD_HYPERVISOR_NONE)
+            hypervisor = gd_internal_hypervisor_find(gd_internal_dmi_hypervisors, sizeof(gd_internal_dmi_hypervisors) / sizeof(gd_internal_dmi_hypervisors[0]), info->product);
+        if (hypervisor != GD_HYPERVISOR_NONE)
+            info->hypervisor = hypervisor;
+    }
+
+    /* Firecracker and the QEMU microvm machine boot the kernel directly, without SMBIOS tables */
+    if (info->hypervisor == GD_HYPERVISOR_KVM && !has_dmi)
+        info->flags |= GD_VIRT_MICROVM;
+
+    /* "5.15.90.1-microsoft-standard-WSL2" for WSL2, "4.4.0-19041-Microsoft" for WSL1 */
+    if (gd_internal_read_file("/proc/sys/kernel/osrelease", buffer, sizeof(buffer)) > 0)
+    {
+        if (strstr(buffer, "Microsoft"))
+            info->flags |= GD_VIRT_WSL | GD_VIRT_SANDBOX;
+        else if (strstr(buffer, "microsoft") || strstr(buffer, "WSL"))
+            info->flags |= GD_VIRT_WSL;
+    }
+
+    /* gVisor reports the same made up kernel build whatever the host runs, "Linux version 4.4.0 #1 SMP Sun Jan 10 15:06:54 PST 2016" */
+    if (gd_internal_read_file("/proc/version", buffer, sizeof(buffer)) > 0 && strstr(buffer, "#1 SMP Sun Jan 10 15:06:54 PST 2016"))
+        info->flags |= GD_VIRT_SANDBOX;
+
+    if (access("/.dockerenv", F_OK) == 0 || access("/run/.containerenv", F_OK) == 0)
+        info->flags |= GD_VIRT_CONTAINER;
+    else if (gd_internal_read_file("/proc/self/cgroup", buffer, sizeof(buffer)) > 0)
+    {
+        for (i = 0; i < sizeof(containers) / sizeof(containers[0]); i++)
+        {
+            if (strstr(buffer, containers[i]))
+                info->flags |= GD_VIRT_CONTAINER;
+        }
+    }
+
+    /* The kernel only keeps the TSC as its clock source while it stays in sync across CPUs */
+    if (gd_internal_read_file("/sys/devices/system/clocksource/clocksource0/current_clocksource", buffer, sizeof(buffer)) > 0)
+    {
+        gd_internal_copy_string(info->clocksource, sizeof(info->clocksource), buffer);
+        if (strcmp(buffer, "tsc") == 0)
+            info->flags |= GD_VIRT_TSC_RELIABLE;
+        else if (strcmp(buffer, "kvm-clock") == 0 || strcmp(buffer, "xen") == 0 || strncmp(buffer, "hyperv", 6) == 0)
+            info->flags |= GD_VIRT_PV_CLOCK;
+    }
+}
+#endif
+
+#if defined(GD_OS_FREEBSD) && !GD_NO_EXTERNAL_INCLUDES
+static const gd_internal_hypervisor_name_t gd_internal_vm_guest_hypervisors[] = {
+    { "kvm", GD_HYPERVISOR_KVM },
+    { "xen", GD_HYPERVISOR_XEN },
+    { "hv", GD_HYPERVISOR_HYPERV },
+    { "vmware", GD_HYPERVISOR_VMWARE },
+    { "vbox", GD_HYPERVISOR_VIRTUALBOX },
+    { "parallels", GD_HYPERVISOR_PARALLELS },
+    { "bhyve", GD_HYPERVISOR_BHYVE },
+    { "generic", GD_HYPERVISOR_UNKNOWN }
+};
+#endif
+
+GD_API int gd_virt_info_probe(gd_virt_info_t* info)
+{
+    gd_internal_memset(info, 0, sizeof(*info));
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    gd_internal_virt_probe_cpuid(info);
+#endif
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    gd_internal_virt_probe_linux(info);
+#elif defined(GD_OS_FREEBSD) && !GD_NO_EXTERNAL_INCLUDES
+    /* "none", "generic", "kvm", "xen", "hv", "vmware", "bhyve", ... */
+    if (info->hypervisor <= GD_HYPERVISOR_UNKNOWN)
+    {
+        char guest[32];
+        size_t size = sizeof(guest);
+        if (sysctlbyname("kern.vm_guest", guest, &size, NULL, 0) == 0 && size > 0 && size <= sizeof(guest))
+        {
+            guest[size - 1] = '\0';
+            if (strcmp(guest, "none") != 0)
+                info->hypervisor = gd_internal_hypervisor_find(gd_internal_vm_guest_hypervisors, sizeof(gd_internal_vm_guest_hypervisors) / sizeof(gd_internal_vm_guest_hypervisors[0]), guest);
+        }
+    }
+#elif defined(GD_OS_GENERIC_APPLE) && GD_INTERNAL_HAS_SYSCTLBYNAME
+    if (info->hypervisor == GD_HYPERVISOR_NONE && gd_internal_sysctl_flag("kern.hv_vmm_present"))
+        info->hypervisor = GD_HYPERVISOR_APPLE;
+#endif
+
+    /* The invariant TSC of bare metal (or of the host) is reliable, in a guest only when the hypervisor or the kernel vouch for it */
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    if ((info->hypervisor == GD_HYPERVISOR_NONE || (info->flags & GD_VIRT_HOST)) && gd_cpu_has(GD_CPU_FEATURE_INVARIANT_TSC))
+        info->flags |= GD_VIRT_TSC_RELIABLE;
+#else
+    info->flags |= GD_VIRT_TSC_RELIABLE;
+#endif
+
+    return info->hypervisor != GD_HYPERVISOR_NONE || (info->flags & (GD_VIRT_SANDBOX | GD_VIRT_CONTAINER | GD_VIRT_WSL)) != 0;
+}
+
+static gd_virt_info_t gd_internal_virt_info;
+static gd_internal_once_t gd_internal_virt_info_once = 0;
+
+GD_API const gd_virt_info_t* gd_virt_info(void)
+{
+    if (gd_internal_once_begin(&gd_internal_virt_info_once))
+    {
+        gd_virt_info_probe(&gd_internal_virt_info);
+        gd_internal_once_end(&gd_internal_virt_info_once);
+    }
+    return &gd_internal_virt_info;
+}
+
+GD_API const char* gd_hypervisor_name(gd_hypervisor_t hypervisor)
+{
+    switch (hypervisor)
+    {
+        case GD_HYPERVISOR_NONE: return "None";
+        case GD_HYPERVISOR_KVM: return "KVM";
+        case GD_HYPERVISOR_XEN: return "Xen";
+        case GD_HYPERVISOR_HYPERV: return "Hyper-V";
+        case GD_HYPERVISOR_VMWARE: return "VMware";
+        case GD_HYPERVISOR_VIRTUALBOX: return "VirtualBox";
+        case GD_HYPERVISOR_QEMU: return "QEMU";
+        case GD_HYPERVISOR_PARALLELS: return "Parallels";
+        case GD_HYPERVISOR_BHYVE: return "bhyve";
+        case GD_HYPERVISOR_ACRN: return "ACRN";
+        case GD_HYPERVISOR_APPLE: return "Apple";
+        default: return "Unknown";
+    }
+}
+
+/* Timer */
+
+/* NOTE: Strict C modes hide clock_gettime in glibc, on Linux the raw syscall is used then */
+GD_API gd_u64_t gd_internal_monotonic_ns(void)
+{
+#if defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (gd_u64_t)(counter.QuadPart / frequency.QuadPart) * (gd_u64_t)1000000000
+        + (gd_u64_t)(counter.QuadPart % frequency.QuadPart) * (gd_u64_t)1000000000 / (gd_u64_t)frequency.QuadPart;
+#elif GD_INTERNAL_HAS_POSIX && defined(CLOCK_MONOTONIC)
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (gd_u64_t)time.tv_sec * (gd_u64_t)1000000000 + (gd_u64_t)time.tv_nsec;
+#elif defined(GD_OS_LINUX) && !GD_NO_EXTERNAL_INCLUDES && defined(SYS_clock_gettime)
+    struct { long seconds; long nanoseconds; } time;
+    syscall(SYS_clock_gettime, 1 /* CLOCK_MONOTONIC */, &time);
+    return (gd_u64_t)time.seconds * (gd_u64_t)1000000000 + (gd_u64_t)time.nanoseconds;
+#elif !GD_NO_EXTERNAL_INCLUDES
+    return (gd_u64_t)clock() * ((gd_u64_t)1000000000 / CLOCKS_PER_SEC);
+#else
+    return 0;
+#endif
+}
+
+GD_API int gd_cycles_invariant(void)
+{
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_HAS_CYCLE_COUNTER
+    return gd_cpu_has(GD_CPU_FEATURE_INVARIANT_TSC);
+#else
+    /* The counters of the other architectures (and the monotonic clock) have a fixed frequency */
+    return 1;
+#endif
+}
+
+static gd_u64_t gd_internal_cycles_frequency_probe(void)
+{
+    gd_u64_t start_ns, start_cycles, elapsed_ns;
+
+#if !GD_HAS_CYCLE_COUNTER
+    return (gd_u64_t)1000000000;
+#elif defined(GD_ARCH_AARCH64) && GD_INTERNAL_GNUC
+    gd_u64_t frequency;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    if (frequency)
+        return frequency;
+#elif (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    /* Leaf 0x15 has the ratio of the TSC to the core crystal clock on newer Intel CPUs */
+    unsigned int regs[4];
+    gd_internal_cpuid(0, 0, regs);
+    if (regs[0] >= 0x15)
+    {
+        gd_internal_cpuid(0x15, 0, regs);
+        if (regs[0] && regs[1] && regs[2])
+            return (gd_u64_t)regs[2] * regs[1] / regs[0];
+    }
+#endif
+
+    /* Calibrate against the monotonic clock for 10 ms */
+    start_ns = gd_internal_monotonic_ns();
+    start_cycles = gd_cycles_serialized();
+    do
+    {
+        elapsed_ns = gd_internal_monotonic_ns() - start_ns;
+    } while (elapsed_ns < (gd_u64_t)10000000);
+    return (gd_cycles_serialized() - start_cycles) * (gd_u64_t)1000000000 / elapsed_ns;
+}
+
+static gd_u64_t gd_internal_cycles_frequency;
+static gd_internal_once_t gd_internal_cycles_frequency_once = 0;
+
+GD_API gd_u64_t gd_cycles_frequency(void)
+{
+    if (gd_internal_once_begin(&gd_internal_cycles_frequency_once))
+    {
+        gd_internal_cycles_frequency = gd_internal_cycles_frequency_probe();
+        gd_internal_once_end(&gd_internal_cycles_frequency_once);
+    }
+    return gd_internal_cycles_frequency;
+}
+
+GD_API gd_u64_t gd_cycles_to_ns(gd_u64_t cycles)
+{
+    gd_u64_t frequency = gd_cycles_frequency();
+    if (frequency == 0)
+        return 0;
+    return cycles / frequency * (gd_u64_t)1000000000 + cycles % frequency * (gd_u64_t)1000000000 / frequency;
+}
+
+/* Allocator */
+
+/*
+ * NOTE: The replacement allocators are found through weak references, which the
+ * dynamic loader also resolves against preloaded libraries. An allocator that
+ * replaces malloc makes it an alias of its own entry point, so comparing the
+ * addresses tells a replacement apart from one that is only linked in. jemalloc
+ * has no such alias, so a malloc has to show up in its per thread statistics.
+ */
+#if GD_INTERNAL_GNUC && defined(__ELF__) && !GD_NO_EXTERNAL_INCLUDES
+    #define GD_INTERNAL_HAS_WEAK_ALLOCATORS 1
+    extern void* mi_malloc(size_t size) __attribute__((weak));
+    extern void* tc_malloc(size_t size) __attribute__((weak));
+    extern void* TCMallocInternalMalloc(size_t size) __attribute__((weak));
+    extern int mallctl(const char* name, void* old_value, size_t* old_length, void* new_value, size_t new_length) __attribute__((weak));
+#else
+    #define GD_INTERNAL_HAS_WEAK_ALLOCATORS 0
+#endif
+
+#if GD_INTERNAL_HAS_WEAK_ALLOCATORS
+/* Returns 1 if malloc is counted by the statistics of jemalloc, which needs a build with them (the default) */
+static int gd_internal_malloc_is_jemalloc(void* (*system_malloc)(size_t))
+{
+    gd_u64_t before, after;
+    size_t length = sizeof(before);
+    void* block;
+
+    if (mallctl("thread.allocated", &before, &length, NULL, 0) != 0)
+        return 0;
+    block = system_malloc(4096);
+    length = sizeof(after);
+    if (!block)
+        return 0;
+    if (mallctl("thread.allocated", &after, &length, NULL, 0) != 0)
+        after = before;
+    free(block);
+    return after != before;
+}
+#endif
+
+GD_API gd_allocator_t gd_allocator(void)
+{
+#if GD_INTERNAL_HAS_WEAK_ALLOCATORS
+    void* (*volatile system_malloc)(size_t) = malloc;
+
+    if (mi_malloc && mi_malloc == system_malloc)
+        return GD_ALLOCATOR_MIMALLOC;
+    if ((tc_malloc && tc_malloc == system_malloc) || (TCMallocInternalMalloc && TCMallocInternalMalloc == system_malloc))
+        return GD_ALLOCATOR_TCMALLOC;
+    if (mallctl && gd_internal_malloc_is_jemalloc(system_malloc))
+        return GD_ALLOCATOR_JEMALLOC;
+#elif defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    if (GetModuleHandleA("mimalloc-redirect.dll"))
+        return GD_ALLOCATOR_MIMALLOC;
+#endif
+
+#if defined(GD_LIBC_GLIBC)
+    return GD_ALLOCATOR_GLIBC;
+#elif defined(GD_LIBC_MUSL)
+    return GD_ALLOCATOR_MUSL;
+#elif defined(GD_LIBC_BIONIC)
+    return GD_ALLOCATOR_BIONIC;
+#elif defined(GD_LIBC_APPLE)
+    return GD_ALLOCATOR_APPLE;
+#elif defined(GD_LIBC_UCRT) || defined(GD_LIBC_MSVCRT)
+    return GD_ALLOCATOR_WINDOWS;
+#elif defined(GD_OS_FREEBSD) || defined(GD_OS_NETBSD)
+    return GD_ALLOCATOR_JEMALLOC;
+#elif defined(GD_LIBC_UCLIBC) || defined(GD_LIBC_NEWLIB) || defined(GD_LIBC_BSD)
+    return GD_ALLOCATOR_LIBC;
+#else
+    return GD_ALLOCATOR_UNKNOWN;
+#endif
+}
+
+GD_API const char* gd_allocator_name(gd_allocator_t allocator)
+{
+    switch (allocator)
+    {
+        case GD_ALLOCATOR_LIBC: return "libc";
+        case GD_ALLOCATOR_GLIBC: return "glibc ptmalloc";
+        case GD_ALLOCATOR_MUSL: return "musl";
+        case GD_ALLOCATOR_BIONIC: return "Bionic";
+        case GD_ALLOCATOR_APPLE: return "Apple libmalloc";
+        case GD_ALLOCATOR_WINDOWS: return "Windows heap";
+        case GD_ALLOCATOR_JEMALLOC: return "jemalloc";
+        case GD_ALLOCATOR_TCMALLOC: return "tcmalloc";
+        case GD_ALLOCATOR_MIMALLOC: return "mimalloc";
+        default: return "Unknown";
+    }
+}
+
+/* Kernel I/O */
+
+/* NOTE: glibc only defines O_DIRECT with _GNU_SOURCE, the values are the ones of the kernel */
+#if defined(GD_OS_LINUX) && !defined(O_DIRECT)
+    #if defined(GD_ARCH_AARCH64) || defined(GD_ARCH_ARM)
+        #define GD_INTERNAL_O_DIRECT 0200000
+    #elif defined(GD_ARCH_POWERPC)
+        #define GD_INTERNAL_O_DIRECT 0400000
+    #elif defined(GD_ARCH_MIPS)
+        #define GD_INTERNAL_O_DIRECT 0100000
+    #elif defined(GD_ARCH_SPARC)
+        #define GD_INTERNAL_O_DIRECT 0x100000
+    #elif defined(GD_ARCH_ALPHA)
+        #define GD_INTERNAL_O_DIRECT 02000000
+    #else
+        #define GD_INTERNAL_O_DIRECT 040000
+    #endif
+#elif defined(O_DIRECT)
+    #define GD_INTERNAL_O_DIRECT O_DIRECT
+#endif
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Checks the result of a syscall called with invalid file descriptors, only a kernel that implements it rejects them */
+static int gd_internal_syscall_rejects_fd(long result)
+{
+    return result == 0 || (result < 0 && errno == EBADF);
+}
+
+/* Closes the file descriptor returned by a syscall, returns 1 if there was one */
+static int gd_internal_syscall_fd(long result)
+{
+    if (result < 0)
+        return 0;
+    close((int)result);
+    return 1;
+}
+
+static void gd_internal_io_probe_uring(gd_io_info_t* info)
+{
+    #if defined(SYS_io_uring_setup) && defined(SYS_io_uring_register)
+    /* struct io_uring_params and struct io_uring_probe, spelled out for older kernel headers */
+    unsigned int params[30];
+    struct { unsigned char last_op, ops_len; unsigned short reserved; unsigned int reserved2[3];
+        struct { unsigned char op, reserved; unsigned short flags; unsigned int reserved2; } ops[256]; } probe;
+    long fd;
+    unsigned int i;
+
+    memset(params, 0, sizeof(params));
+    fd = syscall(SYS_io_uring_setup, 1, params);
+    if (fd < 0)
+        return;
+    info->capabilities |= GD_IO_URING;
+    info->io_uring_features = params[5];
+
+    memset(&probe, 0, sizeof(probe));
+    if (syscall(SYS_io_uring_register, (int)fd, 8 /* IORING_REGISTER_PROBE */, &probe, 256) == 0)
+    {
+        for (i = 0; i < probe.ops_len && i < 256; i++)
+        {
+            if (probe.ops[i].flags & 1) /* IO_URING_OP_SUPPORTED */
+                info->io_uring_opcodes[probe.ops[i].op / 8] |= (unsigned char)(1u << (probe.ops[i].op % 8));
+        }
+    }
+    close((int)fd);
+    #else
+    (void)info;
+    #endif
+}
+
+static void gd_internal_io_probe_linux(gd_io_info_t* info)
+{
+    int socket_fd, enable = 1;
+
+    gd_internal_io_probe_uring(info);
+
+    #if defined(SYS_splice) && defined(SYS_vmsplice)
+    if (gd_internal_syscall_rejects_fd(syscall(SYS_splice, -1, NULL, -1, NULL, 1, 0))
+        && gd_internal_syscall_rejects_fd(syscall(SYS_vmsplice, -1, NULL, 0, 0)))
+        info->capabilities |= GD_IO_SPLICE;
+    #endif
+    #if defined(SYS_copy_file_range)
+    if (gd_internal_syscall_rejects_fd(syscall(SYS_copy_file_range, -1, NULL, -1, NULL, 1, 0)))
+        info->capabilities |= GD_IO_COPY_FILE_RANGE;
+    #endif
+    #if defined(SYS_sendfile)
+    if (gd_internal_syscall_rejects_fd(syscall(SYS_sendfile, -1, -1, NULL, 1)))
+        info->capabilities |= GD_IO_SENDFILE;
+    #endif
+    #if defined(SYS_memfd_create)
+    if (gd_internal_syscall_fd(syscall(SYS_memfd_create, "gd_probe", 1 /* MFD_CLOEXEC */)))
+        info->capabilities |= GD_IO_MEMFD;
+    #endif
+    #if defined(SYS_userfaultfd)
+    if (gd_internal_syscall_fd(syscall(SYS_userfaultfd, O_NONBLOCK)))
+        info->capabilities |= GD_IO_USERFAULTFD;
+    #endif
+
+    /* Linux 4.14+ */
+    socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (socket_fd >= 0)
+    {
+        if (setsockopt(socket_fd, SOL_SOCKET, 60 /* SO_ZEROCOPY */, &enable, sizeof(enable)) == 0)
+            info->capabilities |= GD_IO_MSG_ZEROCOPY;
+        close(socket_fd);
+    }
+}
+#endif
+
+#if (defined(GD_OS_GENERIC_BSD) || defined(GD_OS_GENERIC_APPLE)) && GD_INTERNAL_HAS_POSIX
+static void gd_internal_io_probe_bsd(gd_io_info_t* info)
+{
+    int fd = kqueue();
+    #if defined(GD_OS_FREEBSD) && GD_INTERNAL_HAS_SYSCTLBYNAME
+    /* The __FreeBSD_version of the running kernel, the headers the library was built with can be older */
+    gd_u64_t osreldate = gd_internal_sysctl_u64("kern.osreldate");
+    #endif
+
+    if (fd >= 0)
+    {
+        info->capabilities |= GD_IO_KQUEUE;
+        close(fd);
+    }
+
+    #if defined(GD_OS_FREEBSD) || defined(GD_OS_DRAGONFLY) || defined(GD_OS_GENERIC_APPLE)
+    info->capabilities |= GD_IO_SENDFILE;
+    #endif
+    #if defined(GD_OS_FREEBSD) && GD_INTERNAL_HAS_SYSCTLBYNAME
+    if (osreldate >= 1300037)
+        info->capabilities |= GD_IO_COPY_FILE_RANGE;
+    if (osreldate >= 1300048)
+        info->capabilities |= GD_IO_MEMFD;
+    #endif
+}
+#endif
+
+GD_API int gd_io_info_probe(gd_io_info_t* info)
+{
+    gd_internal_memset(info, 0, sizeof(*info));
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    gd_internal_io_probe_linux(info);
+#elif (defined(GD_OS_GENERIC_BSD) || defined(GD_OS_GENERIC_APPLE)) && GD_INTERNAL_HAS_POSIX
+    gd_internal_io_probe_bsd(info);
+#endif
+    return info->capabilities != 0;
+}
+
+static gd_io_info_t gd_internal_io_info;
+static gd_internal_once_t gd_internal_io_info_once = 0;
+
+GD_API const gd_io_info_t* gd_io_info(void)
+{
+    if (gd_internal_once_begin(&gd_internal_io_info_once))
+    {
+        gd_io_info_probe(&gd_internal_io_info);
+        gd_internal_once_end(&gd_internal_io_info_once);
+    }
+    return &gd_internal_io_info;
+}
+
+GD_API int gd_io_has(unsigned int capabilities)
+{
+    return (gd_io_info()->capabilities & capabilities) == capabilities;
+}
+
+GD_API int gd_io_uring_has_opcode(unsigned int opcode)
+{
+    if (opcode >= 256)
+        return 0;
+    return (gd_io_info()->io_uring_opcodes[opcode / 8] >> (opcode % 8)) & 1;
+}
+
+GD_API int gd_io_direct_supported(const char* path)
+{
+#if GD_INTERNAL_HAS_POSIX && defined(GD_INTERNAL_O_DIRECT)
+    struct stat status;
+    char file[4096];
+    size_t length;
+    int fd;
+
+    if (stat(path, &status) != 0)
+        return 0;
+    if (!S_ISDIR(status.st_mode))
+    {
+        fd = open(path, O_RDONLY | GD_INTERNAL_O_DIRECT);
+        if (fd < 0)
+            return 0;
+        close(fd);
+        return 1;
+    }
+
+    /* Directories can not be opened with O_DIRECT, a new file in them is tried instead */
+    length = strlen(path);
+    if (length + 32 > sizeof(file))
+        return 0;
+    memcpy(file, path, length);
+    gd_internal_make_path(file + length, (int)(sizeof(file) - length), "/.gd_direct_probe_", (unsigned int)getpid(), "");
+    fd = open(file, O_RDWR | O_CREAT | O_EXCL | GD_INTERNAL_O_DIRECT, 0600);
+    if (fd < 0)
+        return 0;
+    unlink(file);
+    close(fd);
+    return 1;
+#else
+    (void)path;
+    return 0;
+#endif
+}
+
+/* Synchronization */
+
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+/* Linux 5.16 / 6.7 numbers, the same on every architecture with the unified syscall table, for older kernel headers */
+#if defined(SYS_futex_waitv)
+    #define GD_INTERNAL_SYS_FUTEX_WAITV SYS_futex_waitv
+#elif !defined(GD_ARCH_MIPS) && !defined(GD_ARCH_ALPHA)
+    #define GD_INTERNAL_SYS_FUTEX_WAITV 449
+#endif
+#if defined(SYS_futex_wake)
+    #define GD_INTERNAL_SYS_FUTEX_WAKE SYS_futex_wake
+#elif !defined(GD_ARCH_MIPS) && !defined(GD_ARCH_ALPHA)
+    #define GD_INTERNAL_SYS_FUTEX_WAKE 454
+#endif
+
+/* The TLS symbols glibc 2.35+ exports after registering rseq, 0 in size when it was disabled by a tunable */
+#if GD_INTERNAL_GNUC && defined(__ELF__) && defined(GD_LIBC_GLIBC)
+    #define GD_INTERNAL_HAS_WEAK_RSEQ 1
+    extern const unsigned int __rseq_size __attribute__((weak));
+#else
+    #define GD_INTERNAL_HAS_WEAK_RSEQ 0
+#endif
+
+/* Each syscall is called with arguments it rejects or that do nothing, a missing or blocked one fails with ENOSYS or EPERM instead */
+static void gd_internal_sync_probe_linux(gd_sync_info_t* info)
+{
+    unsigned int word = 0, cpu = 0;
+    long result;
+
+    #if defined(SYS_futex)
+    if (syscall(SYS_futex, &word, 1 | 128 /* FUTEX_WAKE | FUTEX_PRIVATE_FLAG */, 1, NULL, NULL, 0) == 0)
+        info->capabilities |= GD_SYNC_FUTEX;
+    #endif
+    #if defined(GD_INTERNAL_SYS_FUTEX_WAITV)
+    if (syscall(GD_INTERNAL_SYS_FUTEX_WAITV, NULL, 0, 0, NULL, 0) < 0 && errno == EINVAL)
+        info->capabilities |= GD_SYNC_FUTEX_WAITV;
+    #endif
+    #if defined(GD_INTERNAL_SYS_FUTEX_WAKE)
+    /* The mask can not have bits above the size of the futex */
+    if (syscall(GD_INTERNAL_SYS_FUTEX_WAKE, &word, 0xFFFFFFFFul, 1, 2 | 128 /* FUTEX2_SIZE_U32 | FUTEX2_PRIVATE */) == 0)
+        info->capabilities |= GD_SYNC_FUTEX2;
+    #endif
+
+    #if defined(SYS_membarrier)
+    result = syscall(SYS_membarrier, 0 /* MEMBARRIER_CMD_QUERY */, 0);
+    if (result > 0)
+    {
+        info->membarrier_commands = (unsigned int)result;
+        if (result & (1 << 3)) /* MEMBARRIER_CMD_PRIVATE_EXPEDITED, Linux 4.14+ */
+            info->capabilities |= GD_SYNC_MEMBARRIER;
+    }
+    #else
+    (void)result;
+    #endif
+
+    /* A NULL area is invalid whether or not the thread registered one already */
+    #if defined(SYS_rseq)
+    if (syscall(SYS_rseq, NULL, 0, 0, 0) < 0 && (errno == EINVAL || errno == EBUSY))
+        info->capabilities |= GD_SYNC_RSEQ;
+    #endif
+    #if GD_INTERNAL_HAS_WEAK_RSEQ
+    if (&__rseq_size && __rseq_size)
+        info->capabilities |= GD_SYNC_RSEQ_LIBC;
+    #endif
+
+    #if defined(SYS_getcpu)
+    if (syscall(SYS_getcpu, &cpu, NULL, NULL) == 0)
+        info->capabilities |= GD_SYNC_GETCPU;
+    #else
+    (void)cpu;
+    #endif
+}
+#endif
+
+GD_API int gd_sync_info_probe(gd_sync_info_t* info)
+{
+    gd_internal_memset(info, 0, sizeof(*info));
+#if defined(GD_OS_LINUX) && GD_INTERNAL_HAS_POSIX
+    gd_internal_sync_probe_linux(info);
+#elif defined(GD_OS_WINDOWS) && !GD_NO_EXTERNAL_INCLUDES
+    {
+        /* Looked up instead of linked, so the check works with older SDKs and on Windows 7 */
+        HMODULE kernelbase = GetModuleHandleA("kernelbase.dll");
+        if (kernelbase && GetProcAddress(kernelbase, "WaitOnAddress"))
+            info->capabilities |= GD_SYNC_WAIT_ON_ADDRESS;
+        info->capabilities |= GD_SYNC_MEMBARRIER | GD_SYNC_GETCPU;
+    }
+#elif defined(GD_OS_GENERIC_APPLE) && !GD_NO_EXTERNAL_INCLUDES
+    #if GD_HAS_ULOCK
+    info->capabilities |= GD_SYNC_ULOCK;
+    #endif
+    #if GD_HAS_OS_SYNC_WAIT_ON_ADDRESS
+    info->capabilities |= GD_SYNC_OS_SYNC_WAIT;
+    #else
+    if (dlsym(RTLD_DEFAULT, "os_sync_wait_on_address"))
+        info->capabilities |= GD_SYNC_OS_SYNC_WAIT;
+    #endif
+#elif defined(GD_OS_FREEBSD)
+    info->capabilities |= GD_SYNC_UMTX;
+#elif defined(GD_OS_OPENBSD)
+    info->capabilities |= GD_SYNC_FUTEX;
+#endif
+    return info->capabilities != 0;
+}
+
+static gd_sync_info_t gd_internal_sync_info;
+static gd_internal_once_t gd_internal_sync_info_once = 0;
+
+GD_API const gd_sync_info_t* gd_sync_info(void)
+{
+    if (gd_internal_once_begin(&gd_internal_sync_info_once))
+    {
+        gd_sync_info_probe(&gd_internal_sync_info);
+        gd_internal_once_end(&gd_internal_sync_info_once);
+    }
+    return &gd_internal_sync_info;
+}
+
+GD_API int gd_sync_has(unsigned int capabilities)
+{
+    return (gd_sync_info()->capabilities & capabilities) == capabilities;
+}
+
+/* Snapshot */
+
+#if GD_INTERNAL_HAS_POSIX
+/* "GDSS" in the native byte order, so a snapshot from a machine with the other one never matches */
+#define GD_INTERNAL_SNAPSHOT_MAGIC 0x53534447u
+
+/* Everything that has to be equal for a snapshot to be used, compared as a whole so it must have no padding */
+typedef struct gd_internal_snapshot_header
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int size;              /* Of the whole snapshot, differs for other GD_TOPOLOGY_MAX_* values or data models */
+    unsigned int cpu_signature;     /* Family, model and stepping from cpuid, changes when a VM migrates to another host */
+    gd_u64_t environment;           /* Hash of the cgroups and the CPU affinity of the process */
+    char boot_id[48];
+    char kernel[128];               /* Release and build of the kernel */
+} gd_internal_snapshot_header_t;
+
+typedef struct gd_internal_snapshot
+{
+    gd_internal_snapshot_header_t header;
+    gd_cpu_features_t cpu_features;
+    gd_u64_t cycles_frequency;
+    gd_cpu_model_t cpu_model;
+    gd_cache_info_t cache_info;
+    gd_topology_t topology;
+    gd_page_info_t page_info;
+    gd_limits_t limits;
+    gd_virt_info_t virt_info;
+} gd_internal_snapshot_t;
+
+/* FNV-1a */
+static gd_u64_t gd_internal_hash(gd_u64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * GD_INTERNAL_U64(0x100, 0x1B3);
+    return hash;
+}
+
+/* Fills in the header for the running system, returns 0 if there is no way to tell one boot from the next */
+static int gd_internal_snapshot_key(gd_internal_snapshot_header_t* header)
+{
+    struct utsname name;
+    size_t length;
+#if defined(GD_OS_LINUX)
+    unsigned long words[GD_TOPOLOGY_MAX_CPUS / (sizeof(unsigned long) * 8) + 1];
+    char buffer[4096];
+    long result;
+#elif GD_INTERNAL_HAS_SYSCTLBYNAME
+    struct timeval boot_time;
+    size_t size = sizeof(boot_time);
+#endif
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    unsigned int regs[4];
+#endif
+
+    memset(header, 0, sizeof(*header));
+    header->magic = GD_INTERNAL_SNAPSHOT_MAGIC;
+    header->version = GD_SNAPSHOT_VERSION;
+    header->size = (unsigned int)sizeof(gd_internal_snapshot_t);
+    header->environment = GD_INTERNAL_U64(0xCBF29CE4u, 0x84222325u);
+
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_HAS_CPUID
+    gd_internal_cpuid(1, 0, regs);
+    header->cpu_signature = regs[0];
+#endif
+
+#if defined(GD_OS_LINUX)
+    /* A random UUID generated at every boot, the same in containers as on the host */
+    if (gd_internal_read_file("/proc/sys/kernel/random/boot_id", header->boot_id, (int)sizeof(header->boot_id)) <= 0)
+        return 0;
+
+    /* The cgroup paths of every hierarchy in one file, a process moved to another cgroup has other limits */
+    result = gd_internal_read_file("/proc/self/cgroup", buffer, (int)sizeof(buffer));
+    if (result > 0)
+        header->environment = gd_internal_hash(header->environment, buffer, (size_t)result);
+    memset(words, 0, sizeof(words));
+    result = syscall(SYS_sched_getaffinity, 0, sizeof(words), words);
+    if (result > 0)
+        header->environment = gd_internal_hash(header->environment, words, (size_t)result);
+#elif GD_INTERNAL_HAS_SYSCTLBYNAME
+    if (sysctlbyname("kern.boottime", &boot_time, &size, NULL, 0) != 0 || boot_time.tv_sec == 0)
+        return 0;
+    gd_internal_make_path(header->boot_id, (int)sizeof(header->boot_id), "boottime ", (unsigned int)boot_time.tv_sec, "");
+#else
+    return 0;
+#endif
+
+    if (uname(&name) != 0)
+        return 0;
+    gd_internal_copy_string(header->kernel, sizeof(header->kernel), name.release);
+    length = strlen(header->kernel);
+    if (length + 1 < sizeof(header->kernel))
+    {
+        header->kernel[length] = ' ';
+        gd_internal_copy_string(header->kernel + length + 1, sizeof(header->kernel) - length - 1, name.version);
+    }
+    return 1;
+}
+
+#define GD_INTERNAL_SNAPSHOT_FILL(once, cache, value) \
+    if (gd_internal_once_begin(&(once))) \
+    { \
+        (cache) = (value); \
+        gd_internal_once_end(&(once)); \
+    }
+
+/* Only fills the caches that are still empty, so values a thread already returned never change */
+static void gd_internal_snapshot_apply(const gd_internal_snapshot_t* snapshot)
+{
+    if (gd_internal_cpu_features_load() == 0)
+        gd_internal_cpu_features_store(snapshot->cpu_features);
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_cycles_frequency_once, gd_internal_cycles_frequency, snapshot->cycles_frequency)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_cpu_model_once, gd_internal_cpu_model, snapshot->cpu_model)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_cache_info_once, gd_internal_cache_info, snapshot->cache_info)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_topology_once, gd_internal_topology, snapshot->topology)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_page_info_once, gd_internal_page_info, snapshot->page_info)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_limits_once, gd_internal_limits, snapshot->limits)
+    GD_INTERNAL_SNAPSHOT_FILL(gd_internal_virt_info_once, gd_internal_virt_info, snapshot->virt_info)
+}
+
+#ifdef O_NOFOLLOW
+    #define GD_INTERNAL_SNAPSHOT_CREATE (O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW)
+#else
+    #define GD_INTERNAL_SNAPSHOT_CREATE (O_WRONLY | O_CREAT | O_EXCL)
+#endif
+
+GD_API int gd_snapshot_save(const char* path)
+{
+    gd_internal_snapshot_t* snapshot;
+    char temporary[4096];
+    size_t written = 0;
+    long result;
+    int fd, saved = 0;
+
+    if (!path)
+        path = GD_SNAPSHOT_PATH;
+    if (strlen(path) + 16 > sizeof(temporary))
+        return 0;
+    /* calloc also clears the padding, so the header compares equal byte for byte */
+    snapshot = (gd_internal_snapshot_t*)calloc(1, sizeof(*snapshot));
+    if (!snapshot)
+        return 0;
+
+    if (gd_internal_snapshot_key(&snapshot->header))
+    {
+        /* Probed again, so only what the CPU reports is shared and nothing of how this file was compiled */
+        snapshot->cpu_features = gd_cpu_features_probe();
+        snapshot->cycles_frequency = gd_cycles_frequency();
+        snapshot->cpu_model = *gd_cpu_model();
+        snapshot->cache_info = *gd_cache_info();
+        snapshot->topology = *gd_topology();
+        snapshot->page_info = *gd_page_info();
+        snapshot->limits = *gd_limits();
+        snapshot->virt_info = *gd_virt_info();
+
+        /*
+         * Written next to the old one and renamed over it, so readers never map a partial snapshot. The name is
+         * predictable, so it is only ever created, a file or symlink planted there is never written through. A file
+         * left behind by a crashed process with the same pid is removed once, which only works if it is ours.
+         */
+        gd_internal_make_path(temporary, (int)sizeof(temporary), path, (unsigned int)getpid(), ".tmp");
+        fd = open(temporary, GD_INTERNAL_SNAPSHOT_CREATE, 0644);
+        if (fd < 0 && errno == EEXIST && unlink(temporary) == 0)
+            fd = open(temporary, GD_INTERNAL_SNAPSHOT_CREATE, 0644);
+        if (fd >= 0)
+        {
+            while (written < sizeof(*snapshot) && (result = write(fd, (const char*)snapshot + written, sizeof(*snapshot) - written)) > 0)
+                written += (size_t)result;
+            saved = close(fd) == 0 && written == sizeof(*snapshot) && rename(temporary, path) == 0;
+            if (!saved)
+                unlink(temporary);
+        }
+    }
+    free(snapshot);
+    return saved;
+}
+
+GD_API int gd_snapshot_load(const char* path)
+{
+    gd_internal_snapshot_header_t key;
+    const gd_internal_snapshot_t* snapshot;
+    struct stat status;
+    void* mapping;
+    int fd, valid;
+
+    if (!gd_internal_snapshot_key(&key))
+        return 0;
+    fd = open(path ? path : GD_SNAPSHOT_PATH, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    /* Only trusted when nobody but root or this user could have written it */
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size != (off_t)sizeof(*snapshot)
+        || (status.st_uid != 0 && status.st_uid != geteuid()) || (status.st_mode & (S_IWGRP | S_IWOTH)))
+    {
+        close(fd);
+        return 0;
+    }
+    mapping = mmap(NULL, sizeof(*snapshot), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        return 0;
+
+    snapshot = (const gd_internal_snapshot_t*)mapping;
+    valid = memcmp(&snapshot->header, &key, sizeof(key)) == 0;
+    if (valid)
+        gd_internal_snapshot_apply(snapshot);
+    munmap(mapping, sizeof(*snapshot));
+    return valid;
+}
+#else
+GD_API int gd_snapshot_save(const char* path)
+{
+    (void)path;
+    return 0;
+}
+
+GD_API int gd_snapshot_load(const char* path)
+{
+    (void)path;
+    return 0;
+}
+#endif
+
+GD_API int gd_snapshot_use(const char* path)
+{
+    if (gd_snapshot_load(path))
+        return 1;
+    gd_snapshot_save(path);
+    return 0;
+}
+
+/* ISA check */
+
+/* The features gd_cpu_features_baseline can report, the others are not worth a rebuild on their own */
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    #define GD_INTERNAL_ISA_FEATURES (GD_CPU_FEATURE_SSE | GD_CPU_FEATURE_SSE2 | GD_CPU_FEATURE_SSE3 | GD_CPU_FEATURE_SSSE3 \
+        | GD_CPU_FEATURE_SSE4_1 | GD_CPU_FEATURE_SSE4_2 | GD_CPU_FEATURE_POPCNT | GD_CPU_FEATURE_AVX | GD_CPU_FEATURE_AVX2 \
+        | GD_CPU_FEATURE_FMA | GD_CPU_FEATURE_F16C | GD_CPU_FEATURE_BMI1 | GD_CPU_FEATURE_BMI2 | GD_CPU_FEATURE_LZCNT \
+        | GD_CPU_FEATURE_MOVBE | GD_CPU_FEATURE_AVX512F | GD_CPU_FEATURE_AVX512CD | GD_CPU_FEATURE_AVX512BW \
+        | GD_CPU_FEATURE_AVX512DQ | GD_CPU_FEATURE_AVX512VL | GD_CPU_FEATURE_AVX512IFMA | GD_CPU_FEATURE_AVX512VBMI \
+        | GD_CPU_FEATURE_AVX512VBMI2 | GD_CPU_FEATURE_AVX512VNNI | GD_CPU_FEATURE_AVX512BITALG \
+        | GD_CPU_FEATURE_AVX512VPOPCNTDQ | GD_CPU_FEATURE_AVX512BF16 | GD_CPU_FEATURE_AVX512FP16 \
+        | GD_CPU_FEATURE_AVX10_1 | GD_CPU_FEATURE_AVX10_2 | GD_CPU_FEATURE_CX16)
+#elif defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)
+    #define GD_INTERNAL_ISA_FEATURES (GD_CPU_FEATURE_NEON | GD_CPU_FEATURE_SVE | GD_CPU_FEATURE_SVE2 | GD_CPU_FEATURE_LSE)
+#elif defined(GD_ARCH_RISCV)
+    #define GD_INTERNAL_ISA_FEATURES GD_CPU_FEATURE_V
+#elif defined(GD_ARCH_POWERPC)
+    #define GD_INTERNAL_ISA_FEATURES (GD_CPU_FEATURE_ALTIVEC | GD_CPU_FEATURE_VSX)
+#elif defined(GD_ARCH_LOONGARCH)
+    #define GD_INTERNAL_ISA_FEATURES (GD_CPU_FEATURE_LSX | GD_CPU_FEATURE_LASX)
+#else
+    #define GD_INTERNAL_ISA_FEATURES 0
+#endif
+
+GD_API unsigned int gd_isa_level(gd_cpu_features_t features)
+{
+#if defined(GD_ARCH_X86_64)
+    const gd_cpu_features_t v2 = GD_CPU_FEATURE_SSE3 | GD_CPU_FEATURE_SSSE3 | GD_CPU_FEATURE_SSE4_1 | GD_CPU_FEATURE_SSE4_2
+        | GD_CPU_FEATURE_POPCNT | GD_CPU_FEATURE_CX16;
+    const gd_cpu_features_t v3 = v2 | GD_CPU_FEATURE_AVX | GD_CPU_FEATURE_AVX2 | GD_CPU_FEATURE_BMI1 | GD_CPU_FEATURE_BMI2
+        | GD_CPU_FEATURE_F16C | GD_CPU_FEATURE_FMA | GD_CPU_FEATURE_LZCNT | GD_CPU_FEATURE_MOVBE;
+    const gd_cpu_features_t v4 = v3 | GD_CPU_FEATURE_AVX512F | GD_CPU_FEATURE_AVX512BW | GD_CPU_FEATURE_AVX512CD
+        | GD_CPU_FEATURE_AVX512DQ | GD_CPU_FEATURE_AVX512VL;
+
+    if ((features & v4) == v4)
+        return 4;
+    if ((features & v3) == v3)
+        return 3;
+    if ((features & v2) == v2)
+        return 2;
+    return 1;
+#else
+    (void)features;
+    return 0;
+#endif
+}
+
+GD_API int gd_isa_check_features(gd_cpu_features_t required, gd_isa_check_t* check)
+{
+    gd_cpu_features_t available = gd_cpu_features();
+
+    check->required = required;
+    check->missing = required & ~available;
+    check->unused = available & ~required & GD_INTERNAL_ISA_FEATURES;
+    check->level = gd_isa_level(required);
+    check->host_level = gd_isa_level(available);
+    return check->missing == 0;
+}
+
+GD_API int gd_isa_below_host(const gd_isa_check_t* check)
+{
+    /* NOTE: On x86 only whole levels count, a v4 build on a CPU with more AVX-512 extensions is fine */
+    if (check->level)
+        return check->host_level > check->level;
+    return check->unused != 0;
+}
+
+/* Appends a string, truncating it to the buffer size */
+static void gd_internal_append(char* buffer, unsigned int size, unsigned int* length, const char* string)
+{
+    while (*string && *length + 1 < size)
+        buffer[(*length)++] = *string++;
+    if (size)
+        buffer[*length] = '\0';
+}
+
+static void gd_internal_append_features(char* buffer, unsigned int size, unsigned int* length, gd_cpu_features_t features)
+{
+    int bit;
+    for (bit = 0; bit < GD_CPU_FEATURE_COUNT; bit++)
+    {
+        if (features & GD_CPU_FEATURE(bit))
+        {
+            gd_internal_append(buffer, size, length, " ");
+            gd_internal_append(buffer, size, length, gd_cpu_feature_name(GD_CPU_FEATURE(bit)));
+        }
+    }
+}
+
+static void gd_internal_append_level(char* buffer, unsigned int size, unsigned int* length, unsigned int level)
+{
+    char name[] = "x86-64-v0";
+    name[sizeof(name) - 2] = (char)('0' + level);
+    gd_internal_append(buffer, size, length, name);
+}
+
+GD_API unsigned int gd_isa_report(const gd_isa_check_t* check, char* buffer, unsigned int size)
+{
+    unsigned int length = 0;
+
+    gd_internal_append(buffer, size, &length, "");
+    if (check->missing)
+    {
+        gd_internal_append(buffer, size, &length, "The CPU lacks extensions this build requires:");
+        gd_internal_append_features(buffer, size, &length, check->missing);
+        if (check->level)
+        {
+            gd_internal_append(buffer, size, &length, " (built for ");
+            gd_internal_append_level(buffer, size, &length, check->level);
+            gd_internal_append(buffer, size, &length, ", the CPU supports ");
+            gd_internal_append_level(buffer, size, &length, check->host_level);
+            gd_internal_append(buffer, size, &length, ")");
+        }
+    }
+    else if (gd_isa_below_host(check))
+    {
+        gd_internal_append(buffer, size, &length, "The build is below the CPU capability");
+        if (check->level)
+        {
+            gd_internal_append(buffer, size, &length, ": built for ");
+            gd_internal_append_level(buffer, size, &length, check->level);
+            gd_internal_append(buffer, size, &length, ", the CPU supports ");
+            gd_internal_append_level(buffer, size, &length, check->host_level);
+            gd_internal_append(buffer, size, &length, " (-march=");
+            gd_internal_append_level(buffer, size, &length, check->host_level);
+            gd_internal_append(buffer, size, &length, ")");
+        }
+        else
+        {
+            gd_internal_append(buffer, size, &length, ", unused extensions:");
+            gd_internal_append_features(buffer, size, &length, check->unused);
+        }
+    }
+    else
+    {
+        gd_internal_append(buffer, size, &length, "The CPU matches this build");
+        if (check->level)
+        {
+            gd_internal_append(buffer, size, &length, " (");
+            gd_internal_append_level(buffer, size, &length, check->level);
+            gd_internal_append(buffer, size, &length, ")");
+        }
+    }
+    return length;
+}
+
+GD_API int gd_isa_verify_features(gd_cpu_features_t required, unsigned int flags)
+{
+    gd_isa_check_t check;
+    int ok = gd_isa_check_features(required, &check);
+
+#if !GD_NO_EXTERNAL_INCLUDES
+    if (!ok || ((flags & GD_ISA_VERIFY_SUGGEST) && gd_isa_below_host(&check)))
+    {
+        char report[512];
+        gd_isa_report(&check, report, sizeof(report));
+        fputs(report, stderr);
+        fputs("\n", stderr);
+        if (!ok && !(flags & GD_ISA_VERIFY_NO_ABORT))
+        {
+            fflush(stderr);
+            abort();
+        }
+    }
+#else
+    (void)flags;
+#endif
+    return ok;
+}
+
+/*
+ * NOTE: The check runs before main and C++ static constructors in other files,
+ * but the compiler may already use the new instructions in the startup code of
+ * the C library or in earlier constructors, so it can only catch most cases.
+ */
+#if GD_ISA_CHECK_AT_STARTUP
+    #if GD_INTERNAL_GNUC
+        __attribute__((constructor(101))) static void gd_internal_isa_check_startup(void)
+        {
+            gd_isa_verify_features(gd_cpu_features_baseline(), GD_ISA_CHECK_AT_STARTUP >= 2 ? GD_ISA_VERIFY_SUGGEST : 0);
+        }
+    #elif defined(GD_COMPILER_MSVC)
+        static int __cdecl gd_internal_isa_check_startup(void)
+        {
+            gd_isa_verify_features(gd_cpu_features_baseline(), GD_ISA_CHECK_AT_STARTUP >= 2 ? GD_ISA_VERIFY_SUGGEST : 0);
+            return 0;
+        }
+
+        /* The C runtime calls the functions in .CRT$XIU before the C++ constructors, /include keeps the pointer from being dropped */
+        #pragma section(".CRT$XIU", read)
+        __declspec(allocate(".CRT$XIU")) int (__cdecl* gd_internal_isa_check_startup_pointer)(void) = gd_internal_isa_check_startup;
+        #ifdef GD_ARCH_X86
+            #pragma comment(linker, "/include:_gd_internal_isa_check_startup_pointer")
+        #else
+            #pragma comment(linker, "/include:gd_internal_isa_check_startup_pointer")
+        #endif
+    #elif !GD_NO_CUSTOM_WARNINGS
+        #warning "GD_ISA_CHECK_AT_STARTUP is not supported with this compiler, call gd_isa_verify in main"
+    #endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * GenericDetect - Language standards and parallel runtimes (GD_C_STANDARD, GD_CXX_STANDARD, GD_OPENMP_VERSION, GD_HAS_PSTL)
+ *
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_LANGUAGE_H_
+#define GENERIC_DETECT_LANGUAGE_H_
+
+#include "Compiler.h"
+#include "OS.h"
+#include "LibC.h"
+
+/* Language standard */
+
+/* The year of the standard, drafts count as the standard they lead to, 0 when compiling the other language */
+#if defined(__cplusplus)
+    #define GD_C_STANDARD 0
+#elif defined(__STDC_VERSION__)
+    #if __STDC_VERSION__ > 201710L
+        #define GD_C_STANDARD 2023
+    #elif __STDC_VERSION__ >= 201710L
+        #define GD_C_STANDARD 2017
+    #elif __STDC_VERSION__ >= 201112L
+        #define GD_C_STANDARD 2011
+    #elif __STDC_VERSION__ >= 199901L
+        #define GD_C_STANDARD 1999
+    #elif __STDC_VERSION__ >= 199409L
+        #define GD_C_STANDARD 1995
+    #else
+        #define GD_C_STANDARD 1989
+    #endif
+#elif defined(__STDC__) || defined(_MSC_VER)
+    #define GD_C_STANDARD 1989
+#else
+    #define GD_C_STANDARD 0
+#endif
+
+/* NOTE: MSVC keeps __cplusplus at 199711L unless /Zc:__cplusplus is used, _MSVC_LANG has the real value */
+#if defined(_MSVC_LANG)
+    #define GD_INTERNAL_CXX_VERSION _MSVC_LANG
+#elif defined(__cplusplus)
+    #define GD_INTERNAL_CXX_VERSION __cplusplus
+#else
+    #define GD_INTERNAL_CXX_VERSION 0
+#endif
+
+#if GD_INTERNAL_CXX_VERSION > 202302L
+    #define GD_CXX_STANDARD 2026
+#elif GD_INTERNAL_CXX_VERSION > 202002L
+    #define GD_CXX_STANDARD 2023
+#elif GD_INTERNAL_CXX_VERSION > 201703L
+    #define GD_CXX_STANDARD 2020
+#elif GD_INTERNAL_CXX_VERSION > 201402L
+    #define GD_CXX_STANDARD 2017
+#elif GD_INTERNAL_CXX_VERSION > 201103L
+    #define GD_CXX_STANDARD 2014
+#elif GD_INTERNAL_CXX_VERSION == 201103L
+    #define GD_CXX_STANDARD 2011
+#elif GD_INTERNAL_CXX_VERSION > 0
+    #define GD_CXX_STANDARD 1998
+#else
+    #define GD_CXX_STANDARD 0
+#endif
+
+/* The C++ library reports its features in <version>, or at least its name and configuration in any header */
+#if defined(__cplusplus) && !GD_NO_LIBC_DETECTION
+    #if defined(__has_include)
+        #if __has_include(<version>)
+            #include <version>
+        #else
+            #include <cstddef>
+        #endif
+    #else
+        #include <cstddef>
+    #endif
+#endif
+
+/* OpenMP */
+
+/* 0 when not compiling with OpenMP (-fopenmp, /openmp) */
+#if !defined(_OPENMP)
+    #define GD_OPENMP_VERSION 0
+#elif _OPENMP >= 202411
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(6, 0, 0)
+#elif _OPENMP >= 202111
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(5, 2, 0)
+#elif _OPENMP >= 202011
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(5, 1, 0)
+#elif _OPENMP >= 201811
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(5, 0, 0)
+#elif _OPENMP >= 201511
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(4, 5, 0)
+#elif _OPENMP >= 201307
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(4, 0, 0)
+#elif _OPENMP >= 201107
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(3, 1, 0)
+#elif _OPENMP >= 200805
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(3, 0, 0)
+#elif _OPENMP >= 200505
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(2, 5, 0)
+#else
+    #define GD_OPENMP_VERSION GD_MAKE_VERSION(2, 0, 0)
+#endif
+
+/* Parallel algorithms */
+
+/*
+ * NOTE: libstdc++ picks TBB when its headers are found and runs the algorithms
+ * serially otherwise, the _PSTL_* macros are only there once <execution> was
+ * included. The experimental parallel algorithms of libc++ are not reported.
+ */
+#if GD_CXX_STANDARD >= 2017 && (defined(__cpp_lib_parallel_algorithm) || defined(__cpp_lib_execution))
+    #define GD_HAS_PSTL 1
+    #if defined(_PSTL_PAR_BACKEND_OPENMP)
+        #define GD_PSTL_BACKEND_OPENMP
+        #define GD_PSTL_BACKEND_NAME "OpenMP"
+    #elif defined(_PSTL_PAR_BACKEND_SERIAL)
+        #define GD_PSTL_BACKEND_SERIAL
+        #define GD_PSTL_BACKEND_NAME "Serial"
+    #elif defined(_PSTL_PAR_BACKEND_TBB)
+        #define GD_PSTL_BACKEND_TBB
+        #define GD_PSTL_BACKEND_NAME "TBB"
+    #elif defined(__GLIBCXX__)
+        #if defined(_GLIBCXX_USE_TBB_PAR_BACKEND) && _GLIBCXX_USE_TBB_PAR_BACKEND
+            #define GD_PSTL_BACKEND_TBB
+            #define GD_PSTL_BACKEND_NAME "TBB"
+        #else
+            #define GD_PSTL_BACKEND_SERIAL
+            #define GD_PSTL_BACKEND_NAME "Serial"
+        #endif
+    #elif defined(_MSVC_STL_VERSION) || defined(_LIBCPP_VERSION)
+        /* The Windows thread pool, or std::thread / libdispatch with libc++ */
+        #define GD_PSTL_BACKEND_THREADS
+        #define GD_PSTL_BACKEND_NAME "Threads"
+    #else
+        #define GD_PSTL_BACKEND_SERIAL
+        #define GD_PSTL_BACKEND_NAME "Serial"
+    #endif
+#else
+    #define GD_HAS_PSTL 0
+    #define GD_PSTL_BACKEND_NAME "None"
+#endif
+
+/* Coroutines */
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+    #define GD_HAS_COROUTINES 1
+#else
+    #define GD_HAS_COROUTINES 0
+#endif
+
+/* std::simd */
+
+/* std::simd from C++26 or std::experimental::simd (<experimental/simd>, libstdc++ 11 and newer) */
+#if defined(__cpp_lib_simd)
+    #define GD_HAS_STD_SIMD 1
+    #define GD_STD_SIMD_EXPERIMENTAL 0
+#elif GD_CXX_STANDARD >= 2017 && (defined(__cpp_lib_experimental_parallel_simd) || (defined(_GLIBCXX_RELEASE) && _GLIBCXX_RELEASE >= 11))
+    #define GD_HAS_STD_SIMD 1
+    #define GD_STD_SIMD_EXPERIMENTAL 1
+#else
+    #define GD_HAS_STD_SIMD 0
+    #define GD_STD_SIMD_EXPERIMENTAL 0
+#endif
+
+/* Threads */
+
+/* <thread> in C++, <threads.h> in C */
+#if defined(__cplusplus)
+    #if GD_CXX_STANDARD < 2011 || defined(_LIBCPP_HAS_NO_THREADS)
+        #define GD_HAS_THREADS 0
+    #elif defined(_LIBCPP_HAS_THREADS)
+        #if _LIBCPP_HAS_THREADS
+            #define GD_HAS_THREADS 1
+        #else
+            #define GD_HAS_THREADS 0
+        #endif
+    #elif defined(__GLIBCXX__)
+        /* NOTE: MinGW with win32 threads had no std::thread before GCC 13 */
+        #if defined(_GLIBCXX_HAS_GTHREADS)
+            #define GD_HAS_THREADS 1
+        #else
+            #define GD_HAS_THREADS 0
+        #endif
+    #else
+        #define GD_HAS_THREADS 1
+    #endif
+/* NOTE: Apple and glibc before 2.28 have no threads.h, but do not define __STDC_NO_THREADS__ */
+#elif GD_C_STANDARD >= 2011 && !defined(__STDC_NO_THREADS__) && !defined(GD_OS_GENERIC_APPLE) \
+   && !(defined(GD_LIBC_GLIBC) && GD_LIBC_VERSION < GD_MAKE_VERSION(2, 28, 0))
+    #define GD_HAS_THREADS 1
+#else
+    #define GD_HAS_THREADS 0
+#endif
+
+#endif
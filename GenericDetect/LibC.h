@@ -0,0 +1,110 @@
+/*
+ * GenericDetect - C library detection (GD_LIBC_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_LIBC_H_
+#define GENERIC_DETECT_LIBC_H_
+
+#include "OS.h"
+
+/* LibC detection */
+
+#if !GD_NO_LIBC_DETECTION
+#ifndef __has_include
+#define __has_include() 0
+#endif
+
+#if __has_include(<features.h>)
+#include <features.h>
+#elif defined(GD_OS_WINDOWS)
+/* NOTE: stddef.h pulls in corecrt.h, which defines _UCRT */
+#include <stddef.h>
+#else
+#include <limits.h>
+#endif
+
+/* NOTE: The BSDs keep their version in sys/param.h */
+#if defined(GD_OS_FREEBSD) || defined(GD_OS_NETBSD) || defined(GD_OS_OPENBSD) || defined(GD_OS_DRAGONFLY)
+#include <sys/param.h>
+#endif
+
+/* NOTE: uClibc also defines __GLIBC__, so it has to be checked first */
+#if defined(__UCLIBC__)
+    #define GD_LIBC_UCLIBC
+    #define GD_LIBC_NAME "uClibc"
+    #define GD_LIBC_VERSION GD_MAKE_VERSION(__UCLIBC_MAJOR__, __UCLIBC_MINOR__, __UCLIBC_SUBLEVEL__)
+#elif defined(__BIONIC__)
+    /* The version is the Android API level the code is built for */
+    #define GD_LIBC_BIONIC
+    #define GD_LIBC_NAME "Bionic"
+    #ifdef __ANDROID_API__
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__ANDROID_API__, 0, 0)
+    #endif
+#elif defined(__GLIBC__) || defined(__GNU_LIBRARY__)
+    #define GD_LIBC_GLIBC
+    #define GD_LIBC_NAME "glibc"
+    #ifdef __GLIBC__
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__GLIBC__, __GLIBC_MINOR__, 0)
+    #else
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__GNU_LIBRARY__, __GNU_LIBRARY_MINOR__, 0)
+    #endif
+#elif defined(__NEWLIB__)
+    #define GD_LIBC_NEWLIB
+    #define GD_LIBC_NAME "Newlib"
+    #define GD_LIBC_VERSION GD_MAKE_VERSION(__NEWLIB__, __NEWLIB_MINOR__, __NEWLIB_PATCHLEVEL__)
+#elif defined(_UCRT)
+    #define GD_LIBC_UCRT
+    #define GD_LIBC_NAME "UCRT"
+#elif defined(__MSVCRT__) || (defined(GD_OS_WINDOWS) && defined(_MSC_VER))
+    /* MinGW reports the targeted msvcrt.dll version, e.g. 0x0700 */
+    #define GD_LIBC_MSVCRT
+    #define GD_LIBC_NAME "MSVCRT"
+    #ifdef __MSVCRT_VERSION__
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__MSVCRT_VERSION__ >> 8, __MSVCRT_VERSION__ & 0xFF, 0)
+    #endif
+#elif defined(GD_OS_GENERIC_APPLE)
+    #define GD_LIBC_APPLE
+    #define GD_LIBC_NAME "Apple libc"
+#elif defined(GD_OS_FREEBSD)
+    #define GD_LIBC_BSD
+    #define GD_LIBC_NAME "FreeBSD libc"
+    #ifdef __FreeBSD_version
+        /* e.g. 1401000 for 14.1 */
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__FreeBSD_version / 100000, __FreeBSD_version / 1000 % 100, __FreeBSD_version % 1000)
+    #endif
+#elif defined(GD_OS_NETBSD)
+    #define GD_LIBC_BSD
+    #define GD_LIBC_NAME "NetBSD libc"
+    #ifdef __NetBSD_Version__
+        /* e.g. 1000000000 for 10.0, MMmmrrpp00 */
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__NetBSD_Version__ / 100000000, __NetBSD_Version__ / 1000000 % 100, __NetBSD_Version__ / 100 % 100)
+    #endif
+#elif defined(GD_OS_OPENBSD)
+    #define GD_LIBC_BSD
+    #define GD_LIBC_NAME "OpenBSD libc"
+#elif defined(GD_OS_DRAGONFLY)
+    #define GD_LIBC_BSD
+    #define GD_LIBC_NAME "DragonFly libc"
+    #ifdef __DragonFly_version
+        /* e.g. 600400 for 6.4 */
+        #define GD_LIBC_VERSION GD_MAKE_VERSION(__DragonFly_version / 100000, __DragonFly_version / 100 % 1000, __DragonFly_version % 100)
+    #endif
+#elif defined(GD_OS_LINUX) && __has_include(<features.h>)
+    /* NOTE: musl deliberately has no macro to detect it, it is the remaining Linux libc with features.h */
+    #define GD_LIBC_MUSL
+    #define GD_LIBC_NAME "musl"
+#endif
+#endif
+
+#ifndef GD_LIBC_NAME
+    #define GD_LIBC_NAME "Unknown"
+#endif
+
+#ifndef GD_LIBC_VERSION
+    #define GD_LIBC_VERSION GD_MAKE_VERSION(1, 0, 0)
+#endif
+
+#endif
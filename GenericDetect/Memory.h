@@ -0,0 +1,60 @@
+/*
+ * GenericDetect - Cache line and page sizes (GD_CACHE_LINE_SIZE, GD_PAGE_SIZE_DEFAULT)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_MEMORY_H_
+#define GENERIC_DETECT_MEMORY_H_
+
+#include "OS.h"
+#include "Arch.h"
+
+/* Cache line size */
+
+/* NOTE: The destructive size also covers the adjacent line prefetchers, which pull lines in pairs */
+#ifndef GD_CACHE_LINE_SIZE
+    #if defined(GD_ARCH_AARCH64) && defined(GD_OS_GENERIC_APPLE)
+        #define GD_CACHE_LINE_SIZE 128
+    #elif defined(GD_ARCH_POWERPC64) || defined(GD_ARCH_ITANIUM)
+        #define GD_CACHE_LINE_SIZE 128
+    #elif defined(GD_ARCH_POWERPC32) || defined(GD_ARCH_MIPS32)
+        #define GD_CACHE_LINE_SIZE 32
+    #elif defined(GD_ARCH_M68K)
+        #define GD_CACHE_LINE_SIZE 16
+    #else
+        #define GD_CACHE_LINE_SIZE 64
+    #endif
+#endif
+
+#ifndef GD_DESTRUCTIVE_INTERFERENCE_SIZE
+    #if defined(GD_ARCH_X86_64) || defined(GD_ARCH_AARCH64)
+        #define GD_DESTRUCTIVE_INTERFERENCE_SIZE 128
+    #else
+        #define GD_DESTRUCTIVE_INTERFERENCE_SIZE GD_CACHE_LINE_SIZE
+    #endif
+#endif
+
+#ifndef GD_CONSTRUCTIVE_INTERFERENCE_SIZE
+    #define GD_CONSTRUCTIVE_INTERFERENCE_SIZE GD_CACHE_LINE_SIZE
+#endif
+
+/* Page size */
+
+/* NOTE: This is only the usual size, AArch64 and PowerPC64 Linux kernels can be built with 4K, 16K or 64K pages */
+#ifndef GD_PAGE_SIZE_DEFAULT
+    #if defined(GD_ARCH_AARCH64) && defined(GD_OS_GENERIC_APPLE)
+        #define GD_PAGE_SIZE_DEFAULT 16384
+    #elif defined(GD_ARCH_POWERPC64) && defined(GD_OS_LINUX)
+        #define GD_PAGE_SIZE_DEFAULT 65536
+    #elif defined(GD_ARCH_LOONGARCH) || defined(GD_ARCH_ITANIUM)
+        #define GD_PAGE_SIZE_DEFAULT 16384
+    #elif defined(GD_ARCH_ALPHA) || defined(GD_ARCH_SPARC)
+        #define GD_PAGE_SIZE_DEFAULT 8192
+    #else
+        #define GD_PAGE_SIZE_DEFAULT 4096
+    #endif
+#endif
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * GenericDetect - Operating system detection (GD_OS_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_OS_H_
+#define GENERIC_DETECT_OS_H_
+
+#include "Base.h"
+
+/* OS detection */
+
+#define GD_IS_OS(os) (defined(GD_OS_##os))
+
+#if defined(____386BSD____) || defined(__386BSD__) /* 386BSD */
+    #define GD_OS_386BSD
+    #define GD_OS_GENERIC_BSD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "386BSD"
+#endif
+
+#if defined(_AIX) || defined(__TOS_AIX__) /* AIX */
+    #define GD_OS_AIX
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "AIX"
+#endif
+
+#ifdef AMIX /* Amiga Unix / AMIX */
+    #define GD_OS_AMIX
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "Amiga Unix"
+#endif
+
+#ifdef __ANDROID__ /* Android */
+    #define GD_OS_ANDROID
+    #if !GD_ANDROID_IS_NOT_LINUX
+        #define GD_OS_LINUX
+    #endif
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "Android"
+#endif
+
+#ifdef __BEOS__ /* BeOS */
+    #define GD_OS_BEOS
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "BeOS"
+#endif
+
+#ifdef __DragonFly__ /* DragonFly BSD */
+    #define GD_OS_DRAGONFLY
+    #define GD_OS_GENERIC_BSD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "DragonFly BSD"
+#endif
+
+#if defined(__FreeBSD__) || defined(__FreeBSD_kernel__) /* FreeBSD */
+    #define GD_OS_FREEBSD
+    #define GD_OS_GENERIC_BSD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "FreeBSD"
+#endif
+
+#ifdef __gnu_hurd__ /* GNU/Hurd */
+    #define GD_OS_HURD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "GNU/Hurd"
+#endif
+
+#if defined(_hpux) || defined(hpux) || defined(__hpux) /* HP-UX */
+    #define GD_OS_HPUX
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "HP-UX"
+#endif
+
+#if defined(sgi) || defined(__sgi) /* IRIX */
+    #define GD_OS_IRIX
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "IRIX"
+#endif
+
+#if defined(__linux__) || defined(linux) || defined(__linux) /* Linux */
+    #if !(defined(GD_OS_ANDROID) && GD_ANDROID_IS_NOT_LINUX)
+        #define GD_OS_LINUX
+        #define GD_OS_GENERIC_UNIX
+    #endif
+    #ifndef GD_OS_NAME
+        #define GD_OS_NAME "Linux"
+    #endif
+#endif
+
+#if (defined(__APPLE__) && defined(__MACH__)) || defined(macintosh) || defined(Macintosh) /* MacOS */
+        #define GD_OS_MACOS
+        #define GD_OS_GENERIC_APPLE
+        #define GD_OS_GENERIC_UNIX
+        #define GD_OS_NAME "MacOS"
+#elif defined(__APPLE__) && !GD_NO_EXTERNAL_INCLUDES
+    #include <TargetConditionals.h>
+    #if TARGET_IPHONE_SIMULATOR
+        #define GD_OS_IPHONE_SIMULATOR
+        #define GD_OS_GENERIC_APPLE
+        #define GD_OS_NAME "IPhone Simulator"
+    #elif TARGET_OS_MACCATALYST
+        #define GD_OS_MACCATALYST
+        #define GD_OS_GENERIC_APPLE
+        #define GD_OS_NAME "Mac Catalyst"
+    #elif TARGET_OS_IPHONE
+        #define GD_OS_IOS
+        #define GD_OS_GENERIC_APPLE
+        #define GD_OS_NAME "iOS"
+    #else
+        #if !GD_NO_CUSTOM_WARNINGS
+            #warning "Unknown architecture"
+        #endif
+    #endif
+#endif
+
+#ifdef __minix /* MINIX */
+    #define GD_OS_MINIX
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "MINIX"
+#endif
+
+#if defined(MSDOS) || defined(__MSDOS__) || defined(_MSDOS) || defined(__DOS__) /* MS-DOS */
+    #define GD_OS_MSDOS
+    #define GD_OS_NAME "MS-DOS"
+#endif
+
+#ifdef __NetBSD__ /* NetBSD */
+    #define GD_OS_NETBSD
+    #define GD_OS_GENERIC_BSD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "NetBSD"
+#endif
+
+#ifdef NeXT /* NeXTSTEP */
+    #define GD_OS_NEXTSTEP
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "NeXTSTEP"
+#endif
+
+#ifdef __OpenBSD__ /* OpenBSD */
+    #define GD_OS_OPENBSD
+    #define GD_OS_GENERIC_BSD
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "OpenBSD"
+#endif
+
+#if defined(OS2) || defined(_OS2) || defined(__OS2__) || defined(__TOS_OS2__) /* OS/2 */
+    #define GD_OS_OS2
+    #define GD_OS_NAME "OS/2"
+#endif
+
+#if defined(EPLAN9) /* Plan 9 */
+    #define GD_OS_PLAN9
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "Plan 9"
+#endif
+
+#ifdef __serenity__ /* SerenityOS */
+    #define GD_OS_SERENITY
+    #define GD_OS_GENERIC_UNIX
+    #define GD_OS_NAME "SerenityOS"
+#endif
+
+#if defined(sun) || defined(__sun) /* Solaris / SunOS */
+    #define GD_OS_GENERIC_SUN
+    #define GD_OS_GENERIC_UNIX
+    #if defined(__illumos__)
+        #define GD_OS_ILLUMOS
+        #define GD_OS_NAME "illumos"
+    #elif defined(__SVR4) || defined(__svr4__)
+        #define GD_OS_SOLARIS
+        #define GD_OS_NAME "Solaris"
+    #else
+        #define GD_OS_SUNOS
+        #define GD_OS_NAME "SunOS"
+    #endif
+#endif
+
+#if defined(_WIN16) || defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) || defined(__TOS_WIN__) || defined(__WINDOWS__) /* Windows */
+    #define GD_OS_WINDOWS
+    #define GD_OS_NAME "Windows"
+#endif
+
+#ifndef GD_OS_NAME
+    #if defined(__sysv__) || defined(__SVR4) || defined(__svr4__) || defined(_SYSTYPE_SVR4) /* Generic System V Unix*/
+        #define GD_OS_GENERIC_UNIX
+        #define GD_OS_NAME "Unknown System V Unix"
+    #elif defined(__unix__) || defined(__unix) || defined(unix) || defined(_POSIX_VERSION) || defined(_XOPEN_VERSION) || defined(_XOPEN_UNIX) /* Generic Unix */
+        #define GD_OS_GENERIC_UNIX
+        #define GD_OS_NAME "Unknown Unix"
+    #else
+        #if !GD_NO_CUSTOM_WARNINGS
+            #warning "Unknown operating system"
+        #endif
+        #define GD_OS_NAME "Unknown"
+    #endif
+#endif
+
+#if defined(GD_OS_GENERIC_UNIX)
+#define GD_IS_OS_UNIX 1
+#else
+#define GD_IS_OS_UNIX 0
+#endif
+
+#if defined(GD_OS_GENERIC_BSD)
+#define GD_IS_OS_BSD 1
+#else
+#define GD_IS_OS_BSD 0
+#endif
+
+#if defined(GD_OS_GENERIC_SUN)
+#define GD_IS_OS_SUN 1
+#else
+#define GD_IS_OS_SUN 0
+#endif
+
+#if defined(GD_OS_GENERIC_APPLE)
+#define GD_IS_OS_APPLE 1
+#else
+#define GD_IS_OS_APPLE 0
+#endif
+
+#endif
@@ -0,0 +1,1051 @@
+/*
+ * GenericDetect - Declarations of the runtime detection functions
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_RUNTIME_H_
+#define GENERIC_DETECT_RUNTIME_H_
+
+#include "Compiler.h"
+#include "OS.h"
+#include "Arch.h"
+#include "SIMD.h"
+#include "Memory.h"
+#include "LibC.h"
+#include "Hints.h"
+#include "Bits.h"
+#include "Atomics.h"
+#include "Sync.h"
+
+/* Runtime detection */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* NOTE: The cached values are computed idempotently, so relaxed atomics are enough to publish them */
+#if defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC) || (defined(GD_COMPILER_GCC) && GD_COMPILER_VERSION >= GD_MAKE_VERSION(4, 7, 0))
+    #define GD_INTERNAL_LOAD_U64(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+    #define GD_INTERNAL_STORE_U64(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+#elif defined(GD_COMPILER_MSVC) && defined(GD_ARCH_X86)
+    __int64 _InterlockedCompareExchange64(__int64 volatile*, __int64, __int64);
+    #pragma intrinsic(_InterlockedCompareExchange64)
+    #define GD_INTERNAL_LOAD_U64(ptr) ((gd_u64_t)_InterlockedCompareExchange64((__int64 volatile*)(ptr), 0, 0))
+    #define GD_INTERNAL_STORE_U64(ptr, value) ((void)_InterlockedCompareExchange64((__int64 volatile*)(ptr), (__int64)(value), 0))
+#elif defined(GD_BITS) && GD_BITS == 64
+    /* Aligned 64 bit loads and stores do not tear on 64 bit targets */
+    #define GD_INTERNAL_LOAD_U64(ptr) (*(ptr))
+    #define GD_INTERNAL_STORE_U64(ptr, value) ((void)(*(ptr) = (value)))
+#else
+    /* Plain 64 bit loads and stores can tear here, so 64 bit caches are split into parts that are each marked as written */
+    #define GD_INTERNAL_SPLIT_U64 1
+#endif
+
+/* CPU features */
+
+typedef gd_u64_t gd_cpu_features_t;
+
+#define GD_CPU_FEATURE(bit) (((gd_cpu_features_t)1) << (bit))
+
+/* Always set in the value returned by gd_cpu_features(), so a probed set is never 0 */
+#define GD_CPU_FEATURE_PROBED GD_CPU_FEATURE(63)
+
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    #define GD_CPU_FEATURE_SSE              GD_CPU_FEATURE(0)
+    #define GD_CPU_FEATURE_SSE2             GD_CPU_FEATURE(1)
+    #define GD_CPU_FEATURE_SSE3             GD_CPU_FEATURE(2)
+    #define GD_CPU_FEATURE_SSSE3            GD_CPU_FEATURE(3)
+    #define GD_CPU_FEATURE_SSE4_1           GD_CPU_FEATURE(4)
+    #define GD_CPU_FEATURE_SSE4_2           GD_CPU_FEATURE(5)
+    #define GD_CPU_FEATURE_POPCNT           GD_CPU_FEATURE(6)
+    #define GD_CPU_FEATURE_AVX              GD_CPU_FEATURE(7)
+    #define GD_CPU_FEATURE_AVX2             GD_CPU_FEATURE(8)
+    #define GD_CPU_FEATURE_FMA              GD_CPU_FEATURE(9)
+    #define GD_CPU_FEATURE_F16C             GD_CPU_FEATURE(10)
+    #define GD_CPU_FEATURE_BMI1             GD_CPU_FEATURE(11)
+    #define GD_CPU_FEATURE_BMI2             GD_CPU_FEATURE(12)
+    #define GD_CPU_FEATURE_LZCNT            GD_CPU_FEATURE(13)
+    #define GD_CPU_FEATURE_MOVBE            GD_CPU_FEATURE(14)
+    #define GD_CPU_FEATURE_AES              GD_CPU_FEATURE(15)
+    #define GD_CPU_FEATURE_PCLMULQDQ        GD_CPU_FEATURE(16)
+    #define GD_CPU_FEATURE_SHA              GD_CPU_FEATURE(17)
+    #define GD_CPU_FEATURE_AVX512F          GD_CPU_FEATURE(18)
+    #define GD_CPU_FEATURE_AVX512CD         GD_CPU_FEATURE(19)
+    #define GD_CPU_FEATURE_AVX512BW         GD_CPU_FEATURE(20)
+    #define GD_CPU_FEATURE_AVX512DQ         GD_CPU_FEATURE(21)
+    #define GD_CPU_FEATURE_AVX512VL         GD_CPU_FEATURE(22)
+    #define GD_CPU_FEATURE_AVX512IFMA       GD_CPU_FEATURE(23)
+    #define GD_CPU_FEATURE_AVX512VBMI       GD_CPU_FEATURE(24)
+    #define GD_CPU_FEATURE_AVX512VBMI2      GD_CPU_FEATURE(25)
+    #define GD_CPU_FEATURE_AVX512VNNI       GD_CPU_FEATURE(26)
+    #define GD_CPU_FEATURE_AVX512BITALG     GD_CPU_FEATURE(27)
+    #define GD_CPU_FEATURE_AVX512VPOPCNTDQ  GD_CPU_FEATURE(28)
+    #define GD_CPU_FEATURE_AVX512BF16       GD_CPU_FEATURE(29)
+    #define GD_CPU_FEATURE_AVX512FP16       GD_CPU_FEATURE(30)
+    #define GD_CPU_FEATURE_AVX10_1          GD_CPU_FEATURE(31)
+    #define GD_CPU_FEATURE_AVX10_2          GD_CPU_FEATURE(32)
+    #define GD_CPU_FEATURE_AVXVNNI          GD_CPU_FEATURE(33)
+    #define GD_CPU_FEATURE_GFNI             GD_CPU_FEATURE(34)
+    #define GD_CPU_FEATURE_VAES             GD_CPU_FEATURE(35)
+    #define GD_CPU_FEATURE_VPCLMULQDQ       GD_CPU_FEATURE(36)
+    #define GD_CPU_FEATURE_AMX_TILE         GD_CPU_FEATURE(37)
+    #define GD_CPU_FEATURE_AMX_INT8         GD_CPU_FEATURE(38)
+    #define GD_CPU_FEATURE_AMX_BF16         GD_CPU_FEATURE(39)
+    #define GD_CPU_FEATURE_ADX              GD_CPU_FEATURE(40)
+    #define GD_CPU_FEATURE_RDRAND           GD_CPU_FEATURE(41)
+    #define GD_CPU_FEATURE_RDSEED           GD_CPU_FEATURE(42)
+    #define GD_CPU_FEATURE_ERMS             GD_CPU_FEATURE(43)
+    #define GD_CPU_FEATURE_FSRM             GD_CPU_FEATURE(44)
+    #define GD_CPU_FEATURE_CX8              GD_CPU_FEATURE(45)
+    #define GD_CPU_FEATURE_CX16             GD_CPU_FEATURE(46)
+    #define GD_CPU_FEATURE_RDTSCP           GD_CPU_FEATURE(47)
+    #define GD_CPU_FEATURE_INVARIANT_TSC    GD_CPU_FEATURE(48)
+    #define GD_CPU_FEATURE_HYPERVISOR       GD_CPU_FEATURE(49)
+    #define GD_CPU_FEATURE_COUNT 50
+#elif defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)
+    #define GD_CPU_FEATURE_NEON             GD_CPU_FEATURE(0)
+    #define GD_CPU_FEATURE_FP16             GD_CPU_FEATURE(1)
+    #define GD_CPU_FEATURE_AES              GD_CPU_FEATURE(2)
+    #define GD_CPU_FEATURE_PMULL            GD_CPU_FEATURE(3)
+    #define GD_CPU_FEATURE_SHA1             GD_CPU_FEATURE(4)
+    #define GD_CPU_FEATURE_SHA2             GD_CPU_FEATURE(5)
+    #define GD_CPU_FEATURE_SHA3             GD_CPU_FEATURE(6)
+    #define GD_CPU_FEATURE_SHA512           GD_CPU_FEATURE(7)
+    #define GD_CPU_FEATURE_CRC32            GD_CPU_FEATURE(8)
+    #define GD_CPU_FEATURE_LSE              GD_CPU_FEATURE(9)
+    #define GD_CPU_FEATURE_LSE2             GD_CPU_FEATURE(10)
+    #define GD_CPU_FEATURE_RCPC             GD_CPU_FEATURE(11)
+    #define GD_CPU_FEATURE_DOTPROD          GD_CPU_FEATURE(12)
+    #define GD_CPU_FEATURE_I8MM             GD_CPU_FEATURE(13)
+    #define GD_CPU_FEATURE_BF16             GD_CPU_FEATURE(14)
+    #define GD_CPU_FEATURE_SVE              GD_CPU_FEATURE(15)
+    #define GD_CPU_FEATURE_SVE2             GD_CPU_FEATURE(16)
+    #define GD_CPU_FEATURE_SME              GD_CPU_FEATURE(17)
+    #define GD_CPU_FEATURE_RNG              GD_CPU_FEATURE(18)
+    #define GD_CPU_FEATURE_COUNT 19
+#elif defined(GD_ARCH_RISCV)
+    #define GD_CPU_FEATURE_FD               GD_CPU_FEATURE(0)
+    #define GD_CPU_FEATURE_C                GD_CPU_FEATURE(1)
+    #define GD_CPU_FEATURE_V                GD_CPU_FEATURE(2)
+    #define GD_CPU_FEATURE_ZBA              GD_CPU_FEATURE(3)
+    #define GD_CPU_FEATURE_ZBB              GD_CPU_FEATURE(4)
+    #define GD_CPU_FEATURE_ZBC              GD_CPU_FEATURE(5)
+    #define GD_CPU_FEATURE_ZBS              GD_CPU_FEATURE(6)
+    #define GD_CPU_FEATURE_ZICBOZ           GD_CPU_FEATURE(7)
+    #define GD_CPU_FEATURE_ZICOND           GD_CPU_FEATURE(8)
+    #define GD_CPU_FEATURE_ZFH              GD_CPU_FEATURE(9)
+    #define GD_CPU_FEATURE_ZVFH             GD_CPU_FEATURE(10)
+    #define GD_CPU_FEATURE_ZVBB             GD_CPU_FEATURE(11)
+    #define GD_CPU_FEATURE_ZACAS            GD_CPU_FEATURE(12)
+    #define GD_CPU_FEATURE_ZTSO             GD_CPU_FEATURE(13)
+    #define GD_CPU_FEATURE_COUNT 14
+#elif defined(GD_ARCH_POWERPC)
+    #define GD_CPU_FEATURE_ALTIVEC          GD_CPU_FEATURE(0)
+    #define GD_CPU_FEATURE_VSX              GD_CPU_FEATURE(1)
+    #define GD_CPU_FEATURE_POWER8           GD_CPU_FEATURE(2)
+    #define GD_CPU_FEATURE_POWER9           GD_CPU_FEATURE(3)
+    #define GD_CPU_FEATURE_POWER10          GD_CPU_FEATURE(4)
+    #define GD_CPU_FEATURE_COUNT 5
+#elif defined(GD_ARCH_LOONGARCH)
+    #define GD_CPU_FEATURE_LSX              GD_CPU_FEATURE(0)
+    #define GD_CPU_FEATURE_LASX             GD_CPU_FEATURE(1)
+    #define GD_CPU_FEATURE_COUNT 2
+#else
+    #define GD_CPU_FEATURE_COUNT 0
+#endif
+
+/* Returns the features the code is being compiled for, which every CPU running it has to support */
+GD_INLINE gd_cpu_features_t gd_cpu_features_baseline(void)
+{
+    gd_cpu_features_t features = 0;
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    #ifdef GD_SIMD_SSE
+    features |= GD_CPU_FEATURE_SSE;
+    #endif
+    #ifdef GD_SIMD_SSE2
+    features |= GD_CPU_FEATURE_SSE2;
+    #endif
+    #ifdef GD_SIMD_SSE3
+    features |= GD_CPU_FEATURE_SSE3;
+    #endif
+    #ifdef GD_SIMD_SSSE3
+    features |= GD_CPU_FEATURE_SSSE3;
+    #endif
+    #ifdef GD_SIMD_SSE4_1
+    features |= GD_CPU_FEATURE_SSE4_1;
+    #endif
+    #ifdef GD_SIMD_SSE4_2
+    features |= GD_CPU_FEATURE_SSE4_2;
+    #endif
+    #ifdef GD_SIMD_AVX
+    features |= GD_CPU_FEATURE_AVX;
+    #endif
+    #ifdef GD_SIMD_AVX2
+    features |= GD_CPU_FEATURE_AVX2;
+    #endif
+    #ifdef GD_SIMD_FMA
+    features |= GD_CPU_FEATURE_FMA;
+    #endif
+    #ifdef GD_SIMD_POPCNT
+    features |= GD_CPU_FEATURE_POPCNT;
+    #endif
+    #ifdef GD_SIMD_LZCNT
+    features |= GD_CPU_FEATURE_LZCNT;
+    #endif
+    #ifdef GD_SIMD_BMI1
+    features |= GD_CPU_FEATURE_BMI1;
+    #endif
+    #ifdef GD_SIMD_BMI2
+    features |= GD_CPU_FEATURE_BMI2;
+    #endif
+    #ifdef GD_SIMD_F16C
+    features |= GD_CPU_FEATURE_F16C;
+    #endif
+    #ifdef GD_SIMD_MOVBE
+    features |= GD_CPU_FEATURE_MOVBE;
+    #endif
+    #ifdef GD_SIMD_AVX512F
+    features |= GD_CPU_FEATURE_AVX512F;
+    #endif
+    #ifdef GD_SIMD_AVX512CD
+    features |= GD_CPU_FEATURE_AVX512CD;
+    #endif
+    #ifdef GD_SIMD_AVX512BW
+    features |= GD_CPU_FEATURE_AVX512BW;
+    #endif
+    #ifdef GD_SIMD_AVX512DQ
+    features |= GD_CPU_FEATURE_AVX512DQ;
+    #endif
+    #ifdef GD_SIMD_AVX512VL
+    features |= GD_CPU_FEATURE_AVX512VL;
+    #endif
+    #ifdef GD_SIMD_AVX512IFMA
+    features |= GD_CPU_FEATURE_AVX512IFMA;
+    #endif
+    #ifdef GD_SIMD_AVX512VBMI
+    features |= GD_CPU_FEATURE_AVX512VBMI;
+    #endif
+    #ifdef GD_SIMD_AVX512VBMI2
+    features |= GD_CPU_FEATURE_AVX512VBMI2;
+    #endif
+    #ifdef GD_SIMD_AVX512VNNI
+    features |= GD_CPU_FEATURE_AVX512VNNI;
+    #endif
+    #ifdef GD_SIMD_AVX512BITALG
+    features |= GD_CPU_FEATURE_AVX512BITALG;
+    #endif
+    #ifdef GD_SIMD_AVX512VPOPCNTDQ
+    features |= GD_CPU_FEATURE_AVX512VPOPCNTDQ;
+    #endif
+    #ifdef GD_SIMD_AVX512BF16
+    features |= GD_CPU_FEATURE_AVX512BF16;
+    #endif
+    #ifdef GD_SIMD_AVX512FP16
+    features |= GD_CPU_FEATURE_AVX512FP16;
+    #endif
+    #ifdef GD_SIMD_AVX10
+    features |= GD_CPU_FEATURE_AVX10_1;
+    #if GD_SIMD_AVX10_VERSION >= 2
+    features |= GD_CPU_FEATURE_AVX10_2;
+    #endif
+    #endif
+    #if defined(GD_ARCH_X86_64) && GD_HAS_DWCAS
+    features |= GD_CPU_FEATURE_CX16;
+    #endif
+#elif defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64)
+    #ifdef GD_SIMD_NEON
+    features |= GD_CPU_FEATURE_NEON;
+    #endif
+    #ifdef GD_SIMD_SVE
+    features |= GD_CPU_FEATURE_SVE;
+    #endif
+    #ifdef GD_SIMD_SVE2
+    features |= GD_CPU_FEATURE_SVE2;
+    #endif
+    #if GD_HAS_LSE
+    features |= GD_CPU_FEATURE_LSE;
+    #endif
+#elif defined(GD_ARCH_RISCV)
+    #ifdef GD_SIMD_RVV
+    features |= GD_CPU_FEATURE_V;
+    #endif
+#elif defined(GD_ARCH_POWERPC)
+    #ifdef GD_SIMD_ALTIVEC
+    features |= GD_CPU_FEATURE_ALTIVEC;
+    #endif
+    #ifdef GD_SIMD_VSX
+    features |= GD_CPU_FEATURE_VSX;
+    #endif
+#elif defined(GD_ARCH_LOONGARCH)
+    #ifdef GD_SIMD_LSX
+    features |= GD_CPU_FEATURE_LSX;
+    #endif
+    #ifdef GD_SIMD_LASX
+    features |= GD_CPU_FEATURE_LASX;
+    #endif
+#endif
+    return features;
+}
+
+/* Probes the CPU every time it is called, prefer gd_cpu_features() */
+GD_API gd_cpu_features_t gd_cpu_features_probe(void);
+
+/* Returns the name of a single GD_CPU_FEATURE_* bit, or "Unknown" */
+GD_API const char* gd_cpu_feature_name(gd_cpu_features_t feature);
+
+#ifdef GD_INTERNAL_SPLIT_U64
+/* Four 16 bit parts with bit 16 set once written, a part that was not written yet makes the whole set read as 0 */
+GD_API volatile unsigned int gd_internal_cpu_features[4];
+
+GD_INLINE gd_cpu_features_t gd_internal_cpu_features_load(void)
+{
+    gd_cpu_features_t features = 0;
+    unsigned int part;
+    int i;
+
+    for (i = 3; i >= 0; i--)
+    {
+        part = gd_internal_cpu_features[i];
+        if (!(part & 0x10000u))
+            return 0;
+        features = (features << 16) | (part & 0xFFFFu);
+    }
+    return features;
+}
+
+GD_INLINE void gd_internal_cpu_features_store(gd_cpu_features_t features)
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+        gd_internal_cpu_features[i] = 0x10000u | (unsigned int)((features >> (16 * i)) & 0xFFFFu);
+}
+#else
+GD_API volatile gd_cpu_features_t gd_internal_cpu_features;
+
+#define gd_internal_cpu_features_load() GD_INTERNAL_LOAD_U64(&gd_internal_cpu_features)
+#define gd_internal_cpu_features_store(features) GD_INTERNAL_STORE_U64(&gd_internal_cpu_features, (features))
+#endif
+
+/* Returns the runtime CPU features, probed once and then cached */
+GD_INLINE gd_cpu_features_t gd_cpu_features(void)
+{
+    gd_cpu_features_t features = gd_internal_cpu_features_load();
+    if (features == 0)
+    {
+        features = gd_cpu_features_probe();
+        gd_internal_cpu_features_store(features);
+    }
+    return features;
+}
+
+/* Checks if all of the features passed in are available at runtime */
+GD_INLINE int gd_cpu_has(gd_cpu_features_t features)
+{
+    return (gd_cpu_features() & features) == features;
+}
+
+/* Checks if the running CPU can compare and swap two pointers at once without a lock */
+GD_INLINE int gd_cpu_has_dwcas(void)
+{
+#if defined(GD_ARCH_X86_64)
+    return gd_cpu_has(GD_CPU_FEATURE_CX16);
+#elif defined(GD_ARCH_X86)
+    return gd_cpu_has(GD_CPU_FEATURE_CX8);
+#elif defined(GD_ARCH_AARCH64)
+    /* NOTE: ldxp / stxp are part of the base instruction set, LSE adds casp */
+    return 1;
+#else
+    return GD_HAS_DWCAS;
+#endif
+}
+
+/* CPU model */
+
+typedef enum gd_cpu_vendor
+{
+    GD_CPU_VENDOR_UNKNOWN = 0,
+    GD_CPU_VENDOR_INTEL = 1,
+    GD_CPU_VENDOR_AMD = 2,
+    GD_CPU_VENDOR_HYGON = 3,
+    GD_CPU_VENDOR_ZHAOXIN = 4,   /* Also Centaur / VIA */
+    GD_CPU_VENDOR_ARM = 5,       /* Cortex and Neoverse cores, whoever builds the chip */
+    GD_CPU_VENDOR_APPLE = 6,
+    GD_CPU_VENDOR_QUALCOMM = 7,
+    GD_CPU_VENDOR_AMPERE = 8,
+    GD_CPU_VENDOR_NVIDIA = 9,
+    GD_CPU_VENDOR_FUJITSU = 10,
+    GD_CPU_VENDOR_HISILICON = 11,
+    GD_CPU_VENDOR_CAVIUM = 12,   /* Also Marvell and Broadcom */
+    GD_CPU_VENDOR_IBM = 13
+} gd_cpu_vendor_t;
+
+/* Normalized microarchitectures, the server parts that differ in AVX-512 or SVE behaviour are separate entries */
+typedef enum gd_uarch
+{
+    GD_UARCH_UNKNOWN = 0,
+
+    GD_UARCH_SANDY_BRIDGE = 1,
+    GD_UARCH_IVY_BRIDGE = 2,
+    GD_UARCH_HASWELL = 3,
+    GD_UARCH_BROADWELL = 4,
+    GD_UARCH_SKYLAKE = 5,         /* Also Kaby, Coffee and Comet Lake */
+    GD_UARCH_SKYLAKE_X = 6,       /* Skylake-SP, AVX-512 with heavy frequency drops */
+    GD_UARCH_CASCADE_LAKE = 7,
+    GD_UARCH_COOPER_LAKE = 8,
+    GD_UARCH_ICE_LAKE = 9,
+    GD_UARCH_ICE_LAKE_X = 10,
+    GD_UARCH_TIGER_LAKE = 11,
+    GD_UARCH_ROCKET_LAKE = 12,
+    GD_UARCH_ALDER_LAKE = 13,
+    GD_UARCH_RAPTOR_LAKE = 14,
+    GD_UARCH_METEOR_LAKE = 15,
+    GD_UARCH_ARROW_LAKE = 16,
+    GD_UARCH_LUNAR_LAKE = 17,
+    GD_UARCH_SAPPHIRE_RAPIDS = 18,
+    GD_UARCH_EMERALD_RAPIDS = 19,
+    GD_UARCH_GRANITE_RAPIDS = 20,
+    GD_UARCH_SIERRA_FOREST = 21,
+
+    GD_UARCH_ZEN = 32,            /* Also Hygon Dhyana */
+    GD_UARCH_ZEN_PLUS = 33,
+    GD_UARCH_ZEN2 = 34,
+    GD_UARCH_ZEN3 = 35,
+    GD_UARCH_ZEN4 = 36,
+    GD_UARCH_ZEN5 = 37,
+
+    GD_UARCH_CORTEX_A53 = 64,
+    GD_UARCH_CORTEX_A55 = 65,
+    GD_UARCH_CORTEX_A72 = 66,
+    GD_UARCH_CORTEX_A76 = 67,
+    GD_UARCH_CORTEX_A78 = 68,
+    GD_UARCH_CORTEX_X1 = 69,
+    GD_UARCH_CORTEX_A510 = 70,
+    GD_UARCH_CORTEX_A710 = 71,
+    GD_UARCH_CORTEX_X2 = 72,
+    GD_UARCH_CORTEX_A715 = 73,
+    GD_UARCH_CORTEX_X3 = 74,
+    GD_UARCH_CORTEX_A720 = 75,
+    GD_UARCH_CORTEX_X4 = 76,
+    GD_UARCH_NEOVERSE_N1 = 77,    /* Also Graviton 2 and Ampere Altra */
+    GD_UARCH_NEOVERSE_N2 = 78,
+    GD_UARCH_NEOVERSE_N3 = 79,
+    GD_UARCH_NEOVERSE_V1 = 80,    /* Also Graviton 3 */
+    GD_UARCH_NEOVERSE_V2 = 81,    /* Also Graviton 4 and NVIDIA Grace */
+    GD_UARCH_NEOVERSE_V3 = 82,
+    GD_UARCH_NEOVERSE_E1 = 83,
+    GD_UARCH_APPLE_M1 = 84,
+    GD_UARCH_APPLE_M2 = 85,
+    GD_UARCH_APPLE_M3 = 86,
+    GD_UARCH_APPLE_M4 = 87,
+    GD_UARCH_AMPERE_ONE = 88,
+    GD_UARCH_ORYON = 89,
+    GD_UARCH_A64FX = 90,
+    GD_UARCH_TSV110 = 91,         /* Kunpeng 920 */
+    GD_UARCH_THUNDERX2 = 92,
+
+    GD_UARCH_POWER8 = 112,
+    GD_UARCH_POWER9 = 113,
+    GD_UARCH_POWER10 = 114
+} gd_uarch_t;
+
+typedef struct gd_cpu_model
+{
+    gd_cpu_vendor_t vendor;
+    gd_uarch_t uarch;
+    unsigned int family;   /* The x86 display family, the architecture field of MIDR_EL1 on ARM */
+    unsigned int model;    /* The x86 display model, the part number of MIDR_EL1 on ARM */
+    unsigned int stepping; /* The x86 stepping, variant << 4 | revision of MIDR_EL1 on ARM */
+    gd_u64_t midr;         /* MIDR_EL1 of a performance core on ARM, 0 elsewhere */
+    char brand[49];        /* e.g. "AMD EPYC 9654 96-Core Processor" or "Apple M2", empty if unknown */
+} gd_cpu_model_t;
+
+/* Fills model with the vendor and microarchitecture of the running CPU, returns 0 if the vendor is unknown */
+GD_API int gd_cpu_model_probe(gd_cpu_model_t* model);
+
+/* Returns the CPU model, probed once and then cached */
+GD_API const gd_cpu_model_t* gd_cpu_model(void);
+
+/* Returns the name of a vendor, e.g. "AMD" */
+GD_API const char* gd_cpu_vendor_name(gd_cpu_vendor_t vendor);
+
+/* Returns the name of a microarchitecture, e.g. "Zen 4" */
+GD_API const char* gd_uarch_name(gd_uarch_t uarch);
+
+/* Function dispatch */
+
+/* Resolve GD_DISPATCH functions with GNU indirect functions when supported, only safe with self-contained resolvers */
+#ifndef GD_DISPATCH_IFUNC
+    #define GD_DISPATCH_IFUNC 0
+#endif
+
+/* GNU indirect functions need an ELF target, a compiler that supports them and the glibc dynamic loader */
+#if !defined(GD_HAS_IFUNC)
+    #if ((defined(GD_COMPILER_GCC) && GD_COMPILER_VERSION >= GD_MAKE_VERSION(4, 6, 0)) \
+      || (defined(GD_COMPILER_CLANG) && GD_COMPILER_VERSION >= GD_MAKE_VERSION(3, 9, 0))) \
+     && defined(GD_LIBC_GLIBC) && defined(__ELF__)
+        #define GD_HAS_IFUNC 1
+    #else
+        #define GD_HAS_IFUNC 0
+    #endif
+#endif
+
+#define GD_DISPATCH_TYPE(name) gd_dispatch_##name##_t
+
+#define GD_DISPATCH_DECLARE(ret, name, params) \
+    typedef ret (*GD_DISPATCH_TYPE(name)) params; \
+    ret name params
+
+#if GD_HAS_IFUNC && GD_DISPATCH_IFUNC
+    /* NOTE: The wrapper gives the resolver an unmangled name, which the ifunc attribute needs in C++ */
+    #define GD_DISPATCH(ret, name, params, args, resolver) \
+        GD_INTERNAL_EXTERN_C GD_DISPATCH_TYPE(name) gd_dispatch_##name##_resolve(void); \
+        GD_INTERNAL_EXTERN_C GD_DISPATCH_TYPE(name) gd_dispatch_##name##_resolve(void) { return resolver(); } \
+        ret name params __attribute__((ifunc("gd_dispatch_" #name "_resolve")))
+
+    #define GD_DISPATCH_VOID(name, params, args, resolver) \
+        GD_DISPATCH(void, name, params, args, resolver)
+#else
+    /* NOTE: Racing first calls all resolve to the same function, so relaxed atomics are enough to publish it. The
+             trailing declaration takes the semicolon after GD_DISPATCH */
+    #if defined(GD_COMPILER_CLANG) || defined(GD_COMPILER_ICC) || (defined(GD_COMPILER_GCC) && GD_COMPILER_VERSION >= GD_MAKE_VERSION(4, 7, 0))
+        #define GD_INTERNAL_LOAD_PTR(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+        #define GD_INTERNAL_STORE_PTR(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+    #else
+        /* Aligned pointer sized loads and stores do not tear, volatile keeps them single accesses */
+        #define GD_INTERNAL_LOAD_PTR(ptr) (*(ptr))
+        #define GD_INTERNAL_STORE_PTR(ptr, value) ((void)(*(ptr) = (value)))
+    #endif
+
+    #define GD_DISPATCH(ret, name, params, args, resolver) \
+        static GD_DISPATCH_TYPE(name) volatile gd_dispatch_##name##_target = 0; \
+        ret name params \
+        { \
+            GD_DISPATCH_TYPE(name) target = GD_INTERNAL_LOAD_PTR(&gd_dispatch_##name##_target); \
+            if (!target) \
+            { \
+                target = resolver(); \
+                GD_INTERNAL_STORE_PTR(&gd_dispatch_##name##_target, target); \
+            } \
+            return target args; \
+        } \
+        ret name params
+
+    #define GD_DISPATCH_VOID(name, params, args, resolver) \
+        static GD_DISPATCH_TYPE(name) volatile gd_dispatch_##name##_target = 0; \
+        void name params \
+        { \
+            GD_DISPATCH_TYPE(name) target = GD_INTERNAL_LOAD_PTR(&gd_dispatch_##name##_target); \
+            if (!target) \
+            { \
+                target = resolver(); \
+                GD_INTERNAL_STORE_PTR(&gd_dispatch_##name##_target, target); \
+            } \
+            target args; \
+        } \
+        void name params
+#endif
+
+/* Caches */
+
+#define GD_CACHE_MAX_COUNT 8
+
+/* Used as the associativity of fully associative caches */
+#define GD_CACHE_FULLY_ASSOCIATIVE 0xFFFFFFFFu
+
+typedef enum gd_cache_type
+{
+    GD_CACHE_TYPE_DATA = 1,
+    GD_CACHE_TYPE_INSTRUCTION = 2,
+    GD_CACHE_TYPE_UNIFIED = 3
+} gd_cache_type_t;
+
+typedef struct gd_cache
+{
+    unsigned int level;
+    gd_cache_type_t type;
+    gd_u64_t size;              /* In bytes */
+    unsigned int line_size;     /* In bytes, 0 if unknown */
+    unsigned int associativity; /* Number of ways, 0 if unknown */
+    unsigned int shared_by;     /* Number of logical CPUs sharing the cache, 0 if unknown */
+} gd_cache_t;
+
+typedef struct gd_cache_info
+{
+    unsigned int line_size; /* Line size of the L1 data cache, GD_CACHE_LINE_SIZE if unknown */
+    unsigned int count;
+    gd_cache_t caches[GD_CACHE_MAX_COUNT];
+} gd_cache_info_t;
+
+/* Fills info with the caches of the running CPU, returns 0 if none were found */
+GD_API int gd_cache_info_probe(gd_cache_info_t* info);
+
+/* Returns the cache info, probed once and then cached */
+GD_API const gd_cache_info_t* gd_cache_info(void);
+
+/* Returns the size of the data or unified cache at a level (1 for L1), or 0 if there is none */
+GD_API gd_u64_t gd_cache_size(unsigned int level);
+
+/* Topology */
+
+#ifndef GD_TOPOLOGY_MAX_CPUS
+    #define GD_TOPOLOGY_MAX_CPUS 1024
+#endif
+#ifndef GD_TOPOLOGY_MAX_NODES
+    #define GD_TOPOLOGY_MAX_NODES 64
+#endif
+
+#define GD_CPU_MASK_WORDS ((GD_TOPOLOGY_MAX_CPUS + 63) / 64)
+#define GD_CPU_MASK_HAS(mask, cpu) (((mask)[(cpu) / 64] >> ((cpu) % 64)) & 1)
+
+typedef enum gd_core_type
+{
+    GD_CORE_TYPE_UNKNOWN = 0,    /* Not a hybrid CPU, or the type could not be detected */
+    GD_CORE_TYPE_PERFORMANCE = 1, /* P-core / big core */
+    GD_CORE_TYPE_EFFICIENCY = 2   /* E-core / LITTLE core */
+} gd_core_type_t;
+
+typedef struct gd_topology_cpu
+{
+    unsigned int id;      /* Logical CPU number used by the OS */
+    unsigned int package; /* Index of the package (socket) */
+    unsigned int core;    /* Index of the physical core, unique across packages */
+    unsigned int smt;     /* Index of the thread within its core, 0 for the first sibling */
+    unsigned int node;    /* NUMA node number used by the OS */
+    gd_core_type_t type;
+} gd_topology_cpu_t;
+
+typedef struct gd_numa_node
+{
+    unsigned int id;             /* NUMA node number used by the OS */
+    unsigned int cpu_count;
+    gd_u64_t memory;             /* Total memory in bytes, 0 if unknown */
+    gd_u64_t cpus[GD_CPU_MASK_WORDS];
+    unsigned char distances[GD_TOPOLOGY_MAX_NODES]; /* To every node by index, 10 is local, 0 if unknown */
+} gd_numa_node_t;
+
+typedef struct gd_topology
+{
+    unsigned int cpu_count;      /* Online logical CPUs */
+    unsigned int core_count;     /* Physical cores */
+    unsigned int package_count;
+    unsigned int node_count;
+    unsigned int smt_width;      /* Maximum number of threads per core */
+    unsigned int performance_core_count; /* Physical cores by type, both 0 if not a hybrid CPU */
+    unsigned int efficiency_core_count;
+    gd_topology_cpu_t cpus[GD_TOPOLOGY_MAX_CPUS]; /* Sorted by id */
+    gd_numa_node_t nodes[GD_TOPOLOGY_MAX_NODES];  /* Sorted by id */
+} gd_topology_t;
+
+/* Fills topology with the shape of the machine, returns 0 if it could not be detected */
+GD_API int gd_topology_probe(gd_topology_t* topology);
+
+/* Returns the topology, probed once and then cached */
+GD_API const gd_topology_t* gd_topology(void);
+
+/* Pins the calling thread to a logical CPU or to all CPUs of a NUMA node, returns 0 on failure */
+GD_API int gd_thread_pin_cpu(unsigned int cpu);
+GD_API int gd_thread_pin_node(unsigned int node);
+
+/* Pages */
+
+#define GD_HUGE_PAGE_MAX_COUNT 8
+
+typedef enum gd_thp_mode
+{
+    GD_THP_MODE_UNKNOWN = 0, /* The OS has no transparent huge pages, or the mode could not be read */
+    GD_THP_MODE_NEVER = 1,
+    GD_THP_MODE_MADVISE = 2, /* Only for memory marked with madvise(MADV_HUGEPAGE) */
+    GD_THP_MODE_ALWAYS = 3
+} gd_thp_mode_t;
+
+typedef struct gd_huge_page
+{
+    gd_u64_t size;                 /* In bytes */
+    gd_u64_t total;                /* Pages reserved for hugetlbfs / MAP_HUGETLB, 0 if unknown */
+    gd_u64_t free;                 /* Of those not in use yet, 0 if unknown */
+} gd_huge_page_t;
+
+typedef struct gd_page_info
+{
+    gd_u64_t page_size;            /* Base page size, GD_PAGE_SIZE_DEFAULT if unknown */
+    gd_u64_t allocation_granularity; /* Alignment of new mappings, 64K on Windows, otherwise the page size */
+    gd_thp_mode_t thp_mode;
+    gd_u64_t thp_size;             /* Size of transparent huge pages, 0 if unknown */
+    unsigned int huge_page_count;
+    gd_huge_page_t huge_pages[GD_HUGE_PAGE_MAX_COUNT]; /* Sorted by size */
+} gd_page_info_t;
+
+/* Fills info with the page sizes of the OS, returns 0 if only the defaults could be used */
+GD_API int gd_page_info_probe(gd_page_info_t* info);
+
+/* Returns the page info, probed once and then cached (so the free huge page counts are a snapshot) */
+GD_API const gd_page_info_t* gd_page_info(void);
+
+/* Returns the base page size, probed once and then cached */
+GD_API gd_u64_t gd_page_size(void);
+
+/* Resource limits */
+
+typedef struct gd_limits
+{
+    unsigned int cpu_count;          /* CPUs the process may run on (affinity and cpuset), 0 if unknown */
+    gd_u64_t cpu_quota;              /* CPU time allowed per period, cpu_quota / cpu_period is the number of CPUs, 0 without a quota */
+    gd_u64_t cpu_period;             /* Length of the period, in microseconds for cgroups, 0 without a quota */
+    unsigned int parallelism;        /* Threads that can run at once without being throttled, at least 1 */
+    gd_u64_t memory_total;           /* Physical memory of the machine, 0 if unknown */
+    gd_u64_t memory_max;             /* Hard limit (memory.max, memory.limit_in_bytes, job memory limit), 0 if none */
+    gd_u64_t memory_high;            /* Limit above which the process is throttled and reclaimed (memory.high), 0 if none */
+    gd_u64_t memory_budget;          /* Lowest of the limits and the physical memory, 0 if unknown */
+    unsigned int cgroup_version;     /* 1 or 2 when the limits came from a cgroup, 0 otherwise */
+} gd_limits_t;
+
+/* Fills limits with the CPU and memory the process may use, returns 0 if nothing could be read */
+GD_API int gd_limits_probe(gd_limits_t* limits);
+
+/* Returns the limits, probed once and then cached (limits changed later need gd_limits_probe) */
+GD_API const gd_limits_t* gd_limits(void);
+
+/* Returns the number of threads worth running at once, e.g. for the size of a thread pool */
+GD_API unsigned int gd_parallelism(void);
+
+/* Returns the memory the process can use before it is throttled or killed, in bytes, 0 if unknown */
+GD_API gd_u64_t gd_memory_budget(void);
+
+/* Virtualization */
+
+typedef enum gd_hypervisor
+{
+    GD_HYPERVISOR_NONE = 0,        /* Bare metal, or a hypervisor that hides itself */
+    GD_HYPERVISOR_UNKNOWN = 1,     /* Virtualized, but by none of the ones below */
+    GD_HYPERVISOR_KVM = 2,         /* Also Firecracker, Cloud Hypervisor, crosvm and most clouds */
+    GD_HYPERVISOR_XEN = 3,
+    GD_HYPERVISOR_HYPERV = 4,      /* Also WSL2 and Azure */
+    GD_HYPERVISOR_VMWARE = 5,
+    GD_HYPERVISOR_VIRTUALBOX = 6,
+    GD_HYPERVISOR_QEMU = 7,        /* Emulated by QEMU (TCG), or a QEMU machine of unknown acceleration */
+    GD_HYPERVISOR_PARALLELS = 8,
+    GD_HYPERVISOR_BHYVE = 9,
+    GD_HYPERVISOR_ACRN = 10,
+    GD_HYPERVISOR_APPLE = 11       /* Hypervisor.framework / Virtualization.framework */
+} gd_hypervisor_t;
+
+#define GD_VIRT_HOST           (1u << 0) /* The OS is the privileged host of the hypervisor (Xen dom0, Windows with VBS), close to bare metal */
+#define GD_VIRT_NESTED         (1u << 1) /* VMX or SVM are exposed to the guest, so it can run VMs of its own */
+#define GD_VIRT_SANDBOX        (1u << 2) /* System calls go to a user space kernel (gVisor, WSL1) */
+#define GD_VIRT_CONTAINER      (1u << 3) /* Docker, Podman, LXC or Kubernetes */
+#define GD_VIRT_WSL            (1u << 4) /* Windows Subsystem for Linux, version 2 runs under GD_HYPERVISOR_HYPERV */
+#define GD_VIRT_MICROVM        (1u << 5) /* A minimal VM booted without firmware tables (Firecracker, QEMU microvm) */
+#define GD_VIRT_PV_CLOCK       (1u << 6) /* A paravirtual clock (kvm-clock, Xen, Hyper-V reference TSC page) is available */
+#define GD_VIRT_TSC_RELIABLE   (1u << 7) /* gd_cycles() stays consistent across CPUs and migrations, always the case off x86 */
+#define GD_VIRT_DEDICATED_CPUS (1u << 8) /* The host pins the vCPUs to physical CPUs (KVM realtime hint), so spinning is as cheap as on bare metal */
+
+typedef struct gd_virt_info
+{
+    gd_hypervisor_t hypervisor;
+    unsigned int flags;            /* GD_VIRT_* */
+    char vendor[16];               /* The cpuid hypervisor vendor, e.g. "KVMKVMKVM", empty if unknown */
+    char product[64];              /* The DMI product name, e.g. "Standard PC (Q35 + ICH9, 2009)", empty if unknown */
+    char clocksource[32];          /* The clock source of the Linux kernel, e.g. "tsc" or "kvm-clock", empty if unknown */
+} gd_virt_info_t;
+
+/* Fills info with the virtualization environment, returns 1 if the process runs in a VM, sandbox or container */
+GD_API int gd_virt_info_probe(gd_virt_info_t* info);
+
+/* Returns the virtualization info, probed once and then cached */
+GD_API const gd_virt_info_t* gd_virt_info(void);
+
+/* Returns the name of a hypervisor, e.g. "KVM" */
+GD_API const char* gd_hypervisor_name(gd_hypervisor_t hypervisor);
+
+/* Timer */
+
+/* 1 if gd_cycles() reads a hardware counter, 0 if it falls back to the monotonic clock in nanoseconds */
+#if (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && (GD_INTERNAL_GNUC || GD_INTERNAL_MSVC_INTRINSICS)
+    #define GD_HAS_CYCLE_COUNTER 1
+#elif defined(GD_ARCH_AARCH64) && (GD_INTERNAL_GNUC || GD_INTERNAL_MSVC_INTRINSICS)
+    #define GD_HAS_CYCLE_COUNTER 1
+#elif (defined(GD_ARCH_RISCV) || defined(GD_ARCH_POWERPC) || (defined(GD_ARCH_LOONGARCH) && GD_BITS == 64)) && GD_INTERNAL_GNUC
+    #define GD_HAS_CYCLE_COUNTER 1
+#else
+    #define GD_HAS_CYCLE_COUNTER 0
+#endif
+
+#if GD_HAS_CYCLE_COUNTER && !GD_INTERNAL_GNUC && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    unsigned __int64 __rdtsc(void);
+    void _mm_lfence(void);
+    #pragma intrinsic(__rdtsc)
+#elif GD_HAS_CYCLE_COUNTER && !GD_INTERNAL_GNUC && defined(GD_ARCH_AARCH64)
+    void __isb(unsigned int type);
+    __int64 _ReadStatusReg(int reg);
+#endif
+
+GD_API gd_u64_t gd_internal_monotonic_ns(void);
+
+/*
+ * Reads the cycle counter: rdtsc on x86, cntvct_el0 on AArch64, rdtime on RISC-V,
+ * mftb on PowerPC and rdtime.d on LoongArch. The CPU may execute it out of order
+ * with the code around it.
+ */
+GD_INLINE gd_u64_t gd_cycles(void)
+{
+#if !GD_HAS_CYCLE_COUNTER
+    return gd_internal_monotonic_ns();
+#elif (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_GNUC
+    unsigned int low, high;
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+    return ((gd_u64_t)high << 32) | low;
+#elif defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    return __rdtsc();
+#elif defined(GD_ARCH_AARCH64) && GD_INTERNAL_GNUC
+    gd_u64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#elif defined(GD_ARCH_AARCH64)
+    return (gd_u64_t)_ReadStatusReg(0x5F02); /* ARM64_CNTVCT */
+#elif defined(GD_ARCH_RISCV) && GD_BITS == 64
+    gd_u64_t value;
+    __asm__ __volatile__("rdtime %0" : "=r"(value));
+    return value;
+#elif defined(GD_ARCH_RISCV)
+    unsigned int low, high, check;
+    do
+    {
+        __asm__ __volatile__("rdtimeh %0" : "=r"(high));
+        __asm__ __volatile__("rdtime %0" : "=r"(low));
+        __asm__ __volatile__("rdtimeh %0" : "=r"(check));
+    } while (high != check);
+    return ((gd_u64_t)high << 32) | low;
+#elif defined(GD_ARCH_POWERPC64)
+    gd_u64_t value;
+    __asm__ __volatile__("mfspr %0, 268" : "=r"(value));
+    return value;
+#elif defined(GD_ARCH_POWERPC)
+    unsigned int low, high, check;
+    do
+    {
+        __asm__ __volatile__("mfspr %0, 269" : "=r"(high));
+        __asm__ __volatile__("mfspr %0, 268" : "=r"(low));
+        __asm__ __volatile__("mfspr %0, 269" : "=r"(check));
+    } while (high != check);
+    return ((gd_u64_t)high << 32) | low;
+#else
+    gd_u64_t value;
+    __asm__ __volatile__("rdtime.d %0, $zero" : "=r"(value));
+    return value;
+#endif
+}
+
+/* Like gd_cycles(), but waits for all earlier instructions to finish first and keeps later ones from starting early */
+GD_INLINE gd_u64_t gd_cycles_serialized(void)
+{
+#if !GD_HAS_CYCLE_COUNTER
+    return gd_internal_monotonic_ns();
+#elif (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)) && GD_INTERNAL_GNUC
+    /* NOTE: lfence orders rdtsc on Intel and on AMD with the lfence serialization the kernels turn on */
+    unsigned int low, high;
+    __asm__ __volatile__("lfence\n\trdtsc\n\tlfence" : "=a"(low), "=d"(high) : : "memory");
+    return ((gd_u64_t)high << 32) | low;
+#elif defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    gd_u64_t value;
+    _mm_lfence();
+    value = __rdtsc();
+    _mm_lfence();
+    return value;
+#elif defined(GD_ARCH_AARCH64) && GD_INTERNAL_GNUC
+    gd_u64_t value;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(value) : : "memory");
+    return value;
+#elif defined(GD_ARCH_AARCH64)
+    gd_u64_t value;
+    __isb(15); /* _ARM64_BARRIER_SY */
+    value = (gd_u64_t)_ReadStatusReg(0x5F02);
+    __isb(15);
+    return value;
+#elif defined(GD_ARCH_POWERPC)
+    gd_u64_t value;
+    __asm__ __volatile__("isync" : : : "memory");
+    value = gd_cycles();
+    __asm__ __volatile__("isync" : : : "memory");
+    return value;
+#elif defined(GD_ARCH_RISCV)
+    /* NOTE: RISC-V has no instruction barrier, a full fence is the closest */
+    gd_u64_t value;
+    __asm__ __volatile__("fence rw, rw" : : : "memory");
+    value = gd_cycles();
+    __asm__ __volatile__("fence rw, rw" : : : "memory");
+    return value;
+#else
+    gd_u64_t value;
+    __asm__ __volatile__("dbar 0" : : : "memory");
+    value = gd_cycles();
+    __asm__ __volatile__("dbar 0" : : : "memory");
+    return value;
+#endif
+}
+
+/* Returns 1 if the counter runs at a constant rate, independent of frequency scaling and sleep states */
+GD_API int gd_cycles_invariant(void);
+
+/* Returns the frequency of the counter in Hz, read from the CPU or calibrated once against the monotonic clock */
+GD_API gd_u64_t gd_cycles_frequency(void);
+
+/* Converts a number of cycles to nanoseconds */
+GD_API gd_u64_t gd_cycles_to_ns(gd_u64_t cycles);
+
+/* Allocator */
+
+typedef enum gd_allocator
+{
+    GD_ALLOCATOR_UNKNOWN = 0,
+    GD_ALLOCATOR_LIBC = 1,     /* The default of a C library not listed below */
+    GD_ALLOCATOR_GLIBC = 2,    /* ptmalloc */
+    GD_ALLOCATOR_MUSL = 3,     /* mallocng or oldmalloc */
+    GD_ALLOCATOR_BIONIC = 4,   /* Scudo or jemalloc, depending on the Android version */
+    GD_ALLOCATOR_APPLE = 5,    /* libmalloc */
+    GD_ALLOCATOR_WINDOWS = 6,  /* The UCRT / MSVCRT heap */
+    GD_ALLOCATOR_JEMALLOC = 7, /* Also the default of FreeBSD and NetBSD */
+    GD_ALLOCATOR_TCMALLOC = 8,
+    GD_ALLOCATOR_MIMALLOC = 9
+} gd_allocator_t;
+
+/* Identifies the allocator behind malloc, including replacements that are linked in or preloaded */
+GD_API gd_allocator_t gd_allocator(void);
+
+/* Returns the name of an allocator, e.g. "jemalloc" */
+GD_API const char* gd_allocator_name(gd_allocator_t allocator);
+
+/* Kernel I/O */
+
+#define GD_IO_URING           (1u << 0) /* io_uring_setup works, not disabled by sysctl or seccomp */
+#define GD_IO_SPLICE          (1u << 1) /* splice, vmsplice and tee */
+#define GD_IO_COPY_FILE_RANGE (1u << 2)
+#define GD_IO_SENDFILE        (1u << 3)
+#define GD_IO_MSG_ZEROCOPY    (1u << 4) /* SO_ZEROCOPY can be enabled on TCP sockets */
+#define GD_IO_MEMFD           (1u << 5) /* memfd_create */
+#define GD_IO_USERFAULTFD     (1u << 6) /* userfaultfd, usually only for privileged processes */
+#define GD_IO_KQUEUE          (1u << 7)
+
+typedef struct gd_io_info
+{
+    unsigned int capabilities;         /* GD_IO_* flags */
+    unsigned int io_uring_features;    /* IORING_FEAT_* flags */
+    unsigned char io_uring_opcodes[32]; /* Bitmap of the supported IORING_OP_* opcodes, all 0 before Linux 5.6 */
+} gd_io_info_t;
+
+/* Fills info with the I/O interfaces the kernel provides to this process, returns 0 if none were found */
+GD_API int gd_io_info_probe(gd_io_info_t* info);
+
+/* Returns the I/O info, probed once and then cached */
+GD_API const gd_io_info_t* gd_io_info(void);
+
+/* Checks if all of the GD_IO_* capabilities passed in are available */
+GD_API int gd_io_has(unsigned int capabilities);
+
+/* Checks if io_uring supports an IORING_OP_* opcode */
+GD_API int gd_io_uring_has_opcode(unsigned int opcode);
+
+/* Checks if a file, or new files in a directory, can be opened with O_DIRECT */
+GD_API int gd_io_direct_supported(const char* path);
+
+/* Synchronization */
+
+#define GD_SYNC_FUTEX           (1u << 0)  /* futex with FUTEX_PRIVATE_FLAG (Linux), futex (OpenBSD) */
+#define GD_SYNC_FUTEX_WAITV     (1u << 1)  /* futex_waitv */
+#define GD_SYNC_FUTEX2          (1u << 2)  /* futex_wait / futex_wake with sized futexes */
+#define GD_SYNC_UMTX            (1u << 3)  /* _umtx_op */
+#define GD_SYNC_WAIT_ON_ADDRESS (1u << 4)  /* WaitOnAddress / WakeByAddress* */
+#define GD_SYNC_ULOCK           (1u << 5)  /* __ulock_wait / __ulock_wake */
+#define GD_SYNC_OS_SYNC_WAIT    (1u << 6)  /* os_sync_wait_on_address */
+#define GD_SYNC_MEMBARRIER      (1u << 7)  /* MEMBARRIER_CMD_PRIVATE_EXPEDITED (register it first), FlushProcessWriteBuffers */
+#define GD_SYNC_RSEQ            (1u << 8)  /* The rseq syscall */
+#define GD_SYNC_RSEQ_LIBC       (1u << 9)  /* The C library registered rseq for every thread, use its area instead */
+#define GD_SYNC_GETCPU          (1u << 10) /* getcpu / GetCurrentProcessorNumber */
+
+typedef struct gd_sync_info
+{
+    unsigned int capabilities;        /* GD_SYNC_* */
+    unsigned int membarrier_commands; /* The MEMBARRIER_CMD_* bits returned by MEMBARRIER_CMD_QUERY, 0 elsewhere */
+} gd_sync_info_t;
+
+/* Fills info with the synchronization primitives the kernel lets the process use, returns 0 if none were found */
+GD_API int gd_sync_info_probe(gd_sync_info_t* info);
+
+/* Returns the synchronization info, probed once and then cached */
+GD_API const gd_sync_info_t* gd_sync_info(void);
+
+/* Checks if all of the GD_SYNC_* capabilities passed in are available */
+GD_API int gd_sync_has(unsigned int capabilities);
+
+/* Snapshot */
+
+/* Bumped whenever a struct stored in the snapshot changes, older snapshots are then ignored */
+#define GD_SNAPSHOT_VERSION 1
+
+/* Used when the path passed in is NULL, on tmpfs so it is gone after a reboot anyway */
+#ifndef GD_SNAPSHOT_PATH
+    #define GD_SNAPSHOT_PATH "/run/genericdetect.snapshot"
+#endif
+
+/* Probes everything the snapshot holds and writes it to path, replacing the old one atomically, returns 0 on failure */
+GD_API int gd_snapshot_save(const char* path);
+
+/* Fills the caches that were not probed yet from the snapshot at path, returns 0 if it is missing or stale */
+GD_API int gd_snapshot_load(const char* path);
+
+/* Loads the snapshot, or probes and tries to save one for the next process, returns 1 if it was loaded */
+GD_API int gd_snapshot_use(const char* path);
+
+/* ISA check */
+
+/* 0 - off, 1 - abort at startup when the CPU lacks an extension the implementation file was compiled for, 2 - also report builds below the CPU */
+#ifndef GD_ISA_CHECK_AT_STARTUP
+    #define GD_ISA_CHECK_AT_STARTUP 0
+#endif
+
+#define GD_ISA_VERIFY_NO_ABORT 1u /* Return 0 instead of aborting */
+#define GD_ISA_VERIFY_SUGGEST  2u /* Also report when the CPU could run a better build */
+
+typedef struct gd_isa_check
+{
+    gd_cpu_features_t required; /* The features the code was compiled for */
+    gd_cpu_features_t missing;  /* Required features the CPU lacks, the code can crash with an illegal instruction if not 0 */
+    gd_cpu_features_t unused;   /* Features the CPU has which the compiler could use, but was not told to */
+    unsigned int level;         /* x86-64 microarchitecture level of the required features (1 to 4), 0 on other architectures */
+    unsigned int host_level;    /* x86-64 microarchitecture level of the CPU */
+} gd_isa_check_t;
+
+/* Returns the x86-64 microarchitecture level (1 to 4, -march=x86-64-vN) met by a set of features, 0 on other architectures */
+GD_API unsigned int gd_isa_level(gd_cpu_features_t features);
+
+/* Compares the required features with the running CPU, returns 1 if it can run code compiled for them */
+GD_API int gd_isa_check_features(gd_cpu_features_t required, gd_isa_check_t* check);
+
+/* Compares the features the calling file is compiled for with the running CPU */
+GD_INLINE int gd_isa_check(gd_isa_check_t* check)
+{
+    return gd_isa_check_features(gd_cpu_features_baseline(), check);
+}
+
+/* Checks if the CPU could run code compiled for a higher level or more extensions */
+GD_API int gd_isa_below_host(const gd_isa_check_t* check);
+
+/* Describes the result of a check in one line, listing the missing or unused extensions, returns its length */
+GD_API unsigned int gd_isa_report(const gd_isa_check_t* check, char* buffer, unsigned int size);
+
+/* Checks the required features, writes the report to stderr and aborts if the CPU lacks any (see GD_ISA_VERIFY_*) */
+GD_API int gd_isa_verify_features(gd_cpu_features_t required, unsigned int flags);
+
+/* Same for the features the calling file is compiled for, meant to be called first thing in main */
+GD_INLINE int gd_isa_verify(unsigned int flags)
+{
+    return gd_isa_verify_features(gd_cpu_features_baseline(), flags);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
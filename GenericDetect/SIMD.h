@@ -0,0 +1,248 @@
+/*
+ * GenericDetect - SIMD extension detection (GD_SIMD_*)
+ * 
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_SIMD_H_
+#define GENERIC_DETECT_SIMD_H_
+
+#include "Compiler.h"
+#include "Arch.h"
+
+/* SIMD detection */
+
+#define GD_IS_SIMD(simd) (defined(GD_SIMD_##simd))
+
+#if defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64) /* x86 / x86_64 */
+    /* NOTE: MSVC only defines __AVX__ and up, the SSE levels are implied by /arch or _M_IX86_FP */
+    #if defined(__AVX10_VER__)
+        #define GD_SIMD_AVX10
+        #define GD_SIMD_AVX10_VERSION __AVX10_VER__
+    #elif defined(__AVX10_2__) || defined(__AVX10_2_512__)
+        #define GD_SIMD_AVX10
+        #define GD_SIMD_AVX10_VERSION 2
+    #elif defined(__AVX10_1__) || defined(__AVX10_1_512__)
+        #define GD_SIMD_AVX10
+        #define GD_SIMD_AVX10_VERSION 1
+    #endif
+
+    #if defined(__AVX512FP16__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512FP16
+    #endif
+    #if defined(__AVX512BF16__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512BF16
+    #endif
+    #if defined(__AVX512BITALG__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512BITALG
+    #endif
+    #if defined(__AVX512VPOPCNTDQ__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512VPOPCNTDQ
+    #endif
+    #if defined(__AVX512VNNI__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512VNNI
+    #endif
+    #if defined(__AVX512VBMI2__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512VBMI2
+    #endif
+    #if defined(__AVX512VBMI__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512VBMI
+    #endif
+    #if defined(__AVX512IFMA__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512IFMA
+    #endif
+    #if defined(__AVX512VL__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512VL
+    #endif
+    #if defined(__AVX512DQ__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512DQ
+    #endif
+    #if defined(__AVX512BW__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512BW
+    #endif
+    #if defined(__AVX512CD__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512CD
+    #endif
+    #if defined(__AVX512F__) || defined(GD_SIMD_AVX10)
+        #define GD_SIMD_AVX512F
+    #endif
+
+    #if defined(__AVX2__) || defined(GD_SIMD_AVX512F)
+        #define GD_SIMD_AVX2
+    #endif
+    /* MSVC has no __FMA__, but /arch:AVX2 allows it to emit FMA instructions */
+    #if defined(__FMA__) || defined(GD_SIMD_AVX512F) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_FMA
+    #endif
+    #if defined(__AVX__) || defined(GD_SIMD_AVX2)
+        #define GD_SIMD_AVX
+    #endif
+    #if defined(__SSE4_2__) || defined(GD_SIMD_AVX)
+        #define GD_SIMD_SSE4_2
+    #endif
+    #if defined(__SSE4_1__) || defined(GD_SIMD_SSE4_2)
+        #define GD_SIMD_SSE4_1
+    #endif
+    #if defined(__SSSE3__) || defined(GD_SIMD_SSE4_1)
+        #define GD_SIMD_SSSE3
+    #endif
+    #if defined(__SSE3__) || defined(GD_SIMD_SSSE3)
+        #define GD_SIMD_SSE3
+    #endif
+    #if defined(__SSE2__) || defined(GD_SIMD_SSE3) || defined(GD_ARCH_X86_64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define GD_SIMD_SSE2
+    #endif
+    #if defined(__SSE__) || defined(GD_SIMD_SSE2) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #define GD_SIMD_SSE
+    #endif
+
+    /* Scalar extensions, MSVC can emit them whenever the matching x86-64 level is targeted */
+    #if defined(__POPCNT__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX))
+        #define GD_SIMD_POPCNT
+    #endif
+    #if defined(__LZCNT__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_LZCNT
+    #endif
+    #if defined(__BMI__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_BMI1
+    #endif
+    #if defined(__BMI2__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_BMI2
+    #endif
+    #if defined(__F16C__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_F16C
+    #endif
+    #if defined(__MOVBE__) || (defined(GD_COMPILER_MSVC) && defined(GD_SIMD_AVX2))
+        #define GD_SIMD_MOVBE
+    #endif
+#endif
+
+#if defined(GD_ARCH_ARM) || defined(GD_ARCH_AARCH64) /* ARM / AArch64 */
+    #if defined(__ARM_FEATURE_SVE2)
+        #define GD_SIMD_SVE2
+    #endif
+    #if defined(__ARM_FEATURE_SVE) || defined(GD_SIMD_SVE2)
+        #define GD_SIMD_SVE
+        /* 0 means the vector length is only known at runtime */
+        #ifdef __ARM_FEATURE_SVE_BITS
+            #define GD_SIMD_SVE_BITS __ARM_FEATURE_SVE_BITS
+        #else
+            #define GD_SIMD_SVE_BITS 0
+        #endif
+    #endif
+    /* NOTE: MSVC does not define __ARM_NEON, but NEON is mandatory on all Windows ARM targets */
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(GD_ARCH_AARCH64) || defined(_M_ARM)
+        #define GD_SIMD_NEON
+    #endif
+#endif
+
+#ifdef GD_ARCH_RISCV /* RISC-V */
+    #if defined(__riscv_vector) || defined(__riscv_v)
+        #define GD_SIMD_RVV
+        /* 0 means the vector length is only known at runtime */
+        #if defined(__riscv_v_fixed_vlen)
+            #define GD_SIMD_RVV_BITS __riscv_v_fixed_vlen
+        #else
+            #define GD_SIMD_RVV_BITS 0
+        #endif
+        #if defined(__riscv_v_min_vlen)
+            #define GD_SIMD_RVV_MIN_BITS __riscv_v_min_vlen
+        #else
+            #define GD_SIMD_RVV_MIN_BITS 128
+        #endif
+    #endif
+#endif
+
+#ifdef GD_ARCH_POWERPC /* PowerPC */
+    #ifdef __VSX__
+        #define GD_SIMD_VSX
+    #endif
+    #if defined(__ALTIVEC__) || defined(__APPLE_ALTIVEC__) || defined(GD_SIMD_VSX)
+        #define GD_SIMD_ALTIVEC
+    #endif
+#endif
+
+#ifdef GD_ARCH_LOONGARCH /* LoongArch */
+    #ifdef __loongarch_asx
+        #define GD_SIMD_LASX
+    #endif
+    #if defined(__loongarch_sx) || defined(GD_SIMD_LASX)
+        #define GD_SIMD_LSX
+    #endif
+#endif
+
+/* NOTE: The widest extension goes first, SVE and RVV report their guaranteed minimum width */
+#if defined(GD_SIMD_AVX10)
+    #if GD_SIMD_AVX10_VERSION >= 2
+        #define GD_SIMD_NAME "AVX10.2"
+    #else
+        #define GD_SIMD_NAME "AVX10.1"
+    #endif
+    #define GD_SIMD_MAX_WIDTH_BITS 512
+#elif defined(GD_SIMD_AVX512F)
+    #define GD_SIMD_NAME "AVX-512"
+    #define GD_SIMD_MAX_WIDTH_BITS 512
+#elif defined(GD_SIMD_AVX2)
+    #define GD_SIMD_NAME "AVX2"
+    #define GD_SIMD_MAX_WIDTH_BITS 256
+#elif defined(GD_SIMD_AVX)
+    #define GD_SIMD_NAME "AVX"
+    #define GD_SIMD_MAX_WIDTH_BITS 256
+#elif defined(GD_SIMD_SSE4_2)
+    #define GD_SIMD_NAME "SSE4.2"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SSE4_1)
+    #define GD_SIMD_NAME "SSE4.1"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SSSE3)
+    #define GD_SIMD_NAME "SSSE3"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SSE3)
+    #define GD_SIMD_NAME "SSE3"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SSE2)
+    #define GD_SIMD_NAME "SSE2"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SSE)
+    #define GD_SIMD_NAME "SSE"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_SVE)
+    #ifdef GD_SIMD_SVE2
+        #define GD_SIMD_NAME "SVE2"
+    #else
+        #define GD_SIMD_NAME "SVE"
+    #endif
+    #if GD_SIMD_SVE_BITS > 0
+        #define GD_SIMD_MAX_WIDTH_BITS GD_SIMD_SVE_BITS
+    #else
+        #define GD_SIMD_MAX_WIDTH_BITS 128
+    #endif
+#elif defined(GD_SIMD_NEON)
+    #define GD_SIMD_NAME "NEON"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_RVV)
+    #define GD_SIMD_NAME "RVV"
+    #if GD_SIMD_RVV_BITS > 0
+        #define GD_SIMD_MAX_WIDTH_BITS GD_SIMD_RVV_BITS
+    #else
+        #define GD_SIMD_MAX_WIDTH_BITS GD_SIMD_RVV_MIN_BITS
+    #endif
+#elif defined(GD_SIMD_VSX)
+    #define GD_SIMD_NAME "VSX"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_ALTIVEC)
+    #define GD_SIMD_NAME "AltiVec"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#elif defined(GD_SIMD_LASX)
+    #define GD_SIMD_NAME "LASX"
+    #define GD_SIMD_MAX_WIDTH_BITS 256
+#elif defined(GD_SIMD_LSX)
+    #define GD_SIMD_NAME "LSX"
+    #define GD_SIMD_MAX_WIDTH_BITS 128
+#else
+    #define GD_SIMD_NAME "None"
+    #define GD_SIMD_MAX_WIDTH_BITS 0
+#endif
+
+#endif
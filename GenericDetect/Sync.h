@@ -0,0 +1,104 @@
+/*
+ * GenericDetect - Synchronization primitives of the OS (GD_HAS_FUTEX, GD_HAS_WAIT_ON_ADDRESS, GD_HAS_MEMBARRIER, GD_HAS_RSEQ, ...)
+ *
+ * This file is a part of GenericDetect, see GenericDetect.h for the license
+ * and the usage guide.
+ */
+
+#ifndef GENERIC_DETECT_SYNC_H_
+#define GENERIC_DETECT_SYNC_H_
+
+#include "OS.h"
+#include "LibC.h"
+
+/*
+ * NOTE: These say that the target has an interface. The kernel running the
+ * program can still be too old for it or a seccomp filter can block it, which
+ * gd_sync_info() checks at runtime.
+ */
+
+/* Apple deployment targets, the oldest OS version the program has to run on */
+#if defined(__ENVIRONMENT_MAC_OS_X_VERSION_MIN_REQUIRED__)
+    #define GD_INTERNAL_APPLE_TARGET(macos, ios) (__ENVIRONMENT_MAC_OS_X_VERSION_MIN_REQUIRED__ >= (macos))
+#elif defined(__ENVIRONMENT_IPHONE_OS_VERSION_MIN_REQUIRED__)
+    #define GD_INTERNAL_APPLE_TARGET(macos, ios) (__ENVIRONMENT_IPHONE_OS_VERSION_MIN_REQUIRED__ >= (ios))
+#else
+    #define GD_INTERNAL_APPLE_TARGET(macos, ios) 0
+#endif
+
+/* Waiting on an address */
+
+/* futex(2), called through syscall() on Linux */
+#if defined(GD_OS_LINUX) || defined(GD_OS_OPENBSD)
+    #define GD_HAS_FUTEX 1
+#else
+    #define GD_HAS_FUTEX 0
+#endif
+
+/* futex_waitv (Linux 5.16+) waits on up to 128 futexes at once, futex_wait / futex_wake (Linux 6.7+) take 8 to 64 bit futexes */
+#if defined(GD_OS_LINUX)
+    #define GD_HAS_FUTEX_WAITV 1
+    #define GD_HAS_FUTEX2 1
+#else
+    #define GD_HAS_FUTEX_WAITV 0
+    #define GD_HAS_FUTEX2 0
+#endif
+
+/* _umtx_op with UMTX_OP_WAIT_UINT_PRIVATE / UMTX_OP_WAKE_PRIVATE */
+#if defined(GD_OS_FREEBSD)
+    #define GD_HAS_UMTX 1
+#else
+    #define GD_HAS_UMTX 0
+#endif
+
+/* WaitOnAddress / WakeByAddressSingle (Windows 8+), needs Synchronization.lib */
+#if defined(GD_OS_WINDOWS) && (!defined(_WIN32_WINNT) || _WIN32_WINNT >= 0x0602)
+    #define GD_HAS_WAIT_ON_ADDRESS 1
+#else
+    #define GD_HAS_WAIT_ON_ADDRESS 0
+#endif
+
+/* The private __ulock_wait / __ulock_wake (macOS 10.12+, iOS 10+) and their public successor os_sync_wait_on_address (macOS 14.4+, iOS 17.4+) */
+#if defined(GD_OS_GENERIC_APPLE) && GD_INTERNAL_APPLE_TARGET(101200, 100000)
+    #define GD_HAS_ULOCK 1
+#else
+    #define GD_HAS_ULOCK 0
+#endif
+
+#if defined(GD_OS_GENERIC_APPLE) && GD_INTERNAL_APPLE_TARGET(140400, 170400)
+    #define GD_HAS_OS_SYNC_WAIT_ON_ADDRESS 1
+#else
+    #define GD_HAS_OS_SYNC_WAIT_ON_ADDRESS 0
+#endif
+
+/* Process wide barriers and per CPU data */
+
+/* An asymmetric barrier that orders memory on every thread of the process: membarrier (Linux 4.14+) or FlushProcessWriteBuffers (Windows) */
+#if defined(GD_OS_LINUX) || defined(GD_OS_WINDOWS)
+    #define GD_HAS_MEMBARRIER 1
+#else
+    #define GD_HAS_MEMBARRIER 0
+#endif
+
+/* Restartable sequences (Linux 4.18+), glibc 2.35+ registers them for every thread, so they can not be registered again */
+#if defined(GD_OS_LINUX)
+    #define GD_HAS_RSEQ 1
+#else
+    #define GD_HAS_RSEQ 0
+#endif
+
+#if defined(GD_LIBC_GLIBC) && GD_LIBC_VERSION >= GD_MAKE_VERSION(2, 35, 0)
+    #define GD_HAS_LIBC_RSEQ 1
+#else
+    #define GD_HAS_LIBC_RSEQ 0
+#endif
+
+/* The CPU the thread runs on: sched_getcpu (glibc 2.6+ with _GNU_SOURCE, musl, Bionic) or GetCurrentProcessorNumber (Windows) */
+#if (defined(GD_LIBC_GLIBC) && GD_LIBC_VERSION >= GD_MAKE_VERSION(2, 6, 0)) || defined(GD_LIBC_MUSL) || defined(GD_LIBC_BIONIC) \
+   || defined(GD_OS_WINDOWS)
+    #define GD_HAS_GETCPU 1
+#else
+    #define GD_HAS_GETCPU 0
+#endif
+
+#endif
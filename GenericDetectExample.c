@@ -17,8 +17,27 @@ int main(void)
     printf("- Architecture: %s\n", GD_ARCH_NAME);
     printf("- Architecture version: %s\n", GD_ARCH_VERSION_NAME);
     printf("- Bits: %u\n", GD_BITS);
+    printf("- Endianness: %s\n", GD_ENDIAN_NAME);
+    printf("- Data model: %s\n", GD_DATA_MODEL_NAME);
+    printf("- Calling convention: %s\n", GD_ABI_NAME);
+    printf("- Max alignment: %u\n", GD_MAX_ALIGN);
+    printf("- SIMD: %s\n", GD_SIMD_NAME);
+    printf("- SIMD width: %u bits\n", GD_SIMD_MAX_WIDTH_BITS);
+    printf("- Cache line size: %u\n", GD_CACHE_LINE_SIZE);
     printf("- Compiler: %s\n", GD_COMPILER_NAME);
     printf("- Compiler version: %u.%u.%u\n", GD_VERSION_MAJOR(GD_COMPILER_VERSION), GD_VERSION_MINOR(GD_COMPILER_VERSION), GD_VERSION_PATCH(GD_COMPILER_VERSION));
+    printf("- C standard: %u\n", GD_C_STANDARD);
+    printf("- OpenMP: %s\n", (GD_OPENMP_VERSION ? "yes" : "no"));
+    printf("- C11 threads: %s\n", (GD_HAS_THREADS ? "yes" : "no"));
+    printf("- Build configuration:\n");
+    printf("  - Optimized: %s\n", (GD_BUILD_OPTIMIZED ? (GD_BUILD_OPTIMIZED_SIZE ? "yes (size)" : "yes") : "no"));
+    printf("  - Debug: %s\n", (GD_BUILD_DEBUG ? "yes" : "no"));
+    printf("  - LTO: %s\n", (GD_BUILD_LTO ? "yes" : "no"));
+    printf("  - PGO: %s\n", (GD_BUILD_PGO_GENERATE ? "instrumented" : (GD_BUILD_PGO_USE ? "optimized" : "no")));
+    printf("  - Fast math: %s\n", (GD_FAST_MATH ? "yes" : "no"));
+    printf("  - Sanitizers:%s%s%s%s%s\n", (GD_SANITIZER_ADDRESS ? " address" : ""), (GD_SANITIZER_THREAD ? " thread" : ""),
+        (GD_SANITIZER_MEMORY ? " memory" : ""), (GD_SANITIZER_UNDEFINED ? " undefined" : ""),
+        (GD_SANITIZER_ADDRESS || GD_SANITIZER_THREAD || GD_SANITIZER_MEMORY || GD_SANITIZER_UNDEFINED ? "" : " none"));
     printf("- OS type groups:\n");
     printf("  - Unix: %s\n", (GD_IS_OS_UNIX ? "yes" : "no"));
     printf("  - BSD: %s\n", (GD_IS_OS_BSD ? "yes" : "no"));
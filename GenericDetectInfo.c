@@ -0,0 +1,1021 @@
+/* This file is public domain */
+
+/*
+ * gd-info - prints everything GenericDetect knows about the machine as JSON:
+ * the compile time detection of the build and the runtime detection of the
+ * machine it runs on. With --bench it also measures the load latency of every
+ * cache level and of memory, the single core and all core read bandwidth, the
+ * core to core latency of bouncing a cache line and the throughput of CAS.
+ *
+ * Build: cc -O2 GenericDetectInfo.c -o gd-info -lpthread
+ *        cl /O2 GenericDetectInfo.c /Fe:gd-info.exe
+ * Usage: gd-info [--bench]
+ */
+
+#define GD_IMPLEMENTATION
+#include "GenericDetect.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef GD_OS_WINDOWS
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+/* JSON output */
+
+static int json_depth = 0;
+static int json_first = 1;
+
+static void json_string_value(const char* value)
+{
+    putchar('"');
+    for (; *value; value++)
+    {
+        if (*value == '"' || *value == '\\')
+            putchar('\\');
+        if ((unsigned char)*value >= 0x20)
+            putchar(*value);
+    }
+    putchar('"');
+}
+
+/* Starts a new member of the current object (or element of an array if name is NULL) */
+static void json_key(const char* name)
+{
+    int i;
+    if (!json_first)
+        putchar(',');
+    if (json_depth > 0)
+        putchar('\n');
+    for (i = 0; i < json_depth; i++)
+        fputs("  ", stdout);
+    if (name)
+    {
+        json_string_value(name);
+        fputs(": ", stdout);
+    }
+    json_first = 0;
+}
+
+static void json_begin(const char* name, char bracket)
+{
+    json_key(name);
+    putchar(bracket);
+    json_depth++;
+    json_first = 1;
+}
+
+static void json_end(char bracket)
+{
+    int i;
+    json_depth--;
+    if (!json_first)
+    {
+        putchar('\n');
+        for (i = 0; i < json_depth; i++)
+            fputs("  ", stdout);
+    }
+    putchar(bracket);
+    json_first = 0;
+}
+
+#define json_begin_object(name) json_begin(name, '{')
+#define json_end_object() json_end('}')
+#define json_begin_array(name) json_begin(name, '[')
+#define json_end_array() json_end(']')
+
+static void json_string(const char* name, const char* value)
+{
+    json_key(name);
+    json_string_value(value);
+}
+
+static void json_uint(const char* name, unsigned long long value)
+{
+    json_key(name);
+    printf("%llu", value);
+}
+
+static void json_int(const char* name, long long value)
+{
+    json_key(name);
+    printf("%lld", value);
+}
+
+static void json_double(const char* name, double value)
+{
+    json_key(name);
+    printf("%.3f", value);
+}
+
+/* Measurements are negative when they were skipped, e.g. because the threads could not be pinned */
+static void json_measurement(const char* name, double value)
+{
+    if (value < 0)
+    {
+        json_key(name);
+        fputs("null", stdout);
+    }
+    else
+        json_double(name, value);
+}
+
+static void json_bool(const char* name, int value)
+{
+    json_key(name);
+    fputs(value ? "true" : "false", stdout);
+}
+
+static void json_version(const char* name, unsigned int version)
+{
+    char buffer[32];
+    sprintf(buffer, "%u.%u.%u", GD_VERSION_MAJOR(version), GD_VERSION_MINOR(version), GD_VERSION_PATCH(version));
+    json_string(name, buffer);
+}
+
+static void json_features(const char* name, gd_cpu_features_t features)
+{
+    int bit;
+    json_begin_array(name);
+    for (bit = 0; bit < GD_CPU_FEATURE_COUNT; bit++)
+        if (features & GD_CPU_FEATURE(bit))
+            json_string(NULL, gd_cpu_feature_name(GD_CPU_FEATURE(bit)));
+    json_end_array();
+}
+
+/* Compile time detection */
+
+static void print_compile_time(void)
+{
+    json_begin_object("compile_time");
+
+    json_begin_object("compiler");
+    json_string("name", GD_COMPILER_NAME);
+    json_version("version", GD_COMPILER_VERSION);
+    json_int("c_standard", GD_C_STANDARD);
+    json_int("cxx_standard", GD_CXX_STANDARD);
+    json_version("openmp", GD_OPENMP_VERSION);
+    json_end_object();
+
+    json_begin_object("os");
+    json_string("name", GD_OS_NAME);
+    json_bool("unix", GD_IS_OS_UNIX);
+    json_bool("bsd", GD_IS_OS_BSD);
+    json_bool("sun", GD_IS_OS_SUN);
+    json_bool("apple", GD_IS_OS_APPLE);
+    json_end_object();
+
+    json_begin_object("libc");
+    json_string("name", GD_LIBC_NAME);
+    json_version("version", GD_LIBC_VERSION);
+    json_end_object();
+
+    json_begin_object("arch");
+    json_string("name", GD_ARCH_NAME);
+    json_string("version", GD_ARCH_VERSION_NAME);
+    json_int("bits", GD_BITS);
+    json_string("endian", GD_ENDIAN_NAME);
+    json_string("data_model", GD_DATA_MODEL_NAME);
+    json_string("abi", GD_ABI_NAME);
+    json_int("sizeof_pointer", GD_SIZEOF_POINTER);
+    json_int("sizeof_long", GD_SIZEOF_LONG);
+    json_int("sizeof_long_double", GD_SIZEOF_LONG_DOUBLE);
+    json_int("max_align", GD_MAX_ALIGN);
+    json_end_object();
+
+    json_begin_object("simd");
+    json_string("name", GD_SIMD_NAME);
+    json_int("width_bits", GD_SIMD_MAX_WIDTH_BITS);
+    json_features("baseline", gd_cpu_features_baseline());
+    json_end_object();
+
+    json_begin_object("memory");
+    json_int("cache_line_size", GD_CACHE_LINE_SIZE);
+    json_int("destructive_interference_size", GD_DESTRUCTIVE_INTERFERENCE_SIZE);
+    json_int("constructive_interference_size", GD_CONSTRUCTIVE_INTERFERENCE_SIZE);
+    json_int("page_size_default", GD_PAGE_SIZE_DEFAULT);
+    json_bool("lock_free_128", GD_ATOMIC_LOCK_FREE_128);
+    json_bool("memory_model_tso", GD_MEMORY_MODEL_TSO);
+    json_end_object();
+
+    json_begin_object("build");
+    json_bool("optimized", GD_BUILD_OPTIMIZED);
+    json_bool("optimized_size", GD_BUILD_OPTIMIZED_SIZE);
+    json_bool("debug", GD_BUILD_DEBUG);
+    json_bool("lto", GD_BUILD_LTO);
+    json_bool("pgo_generate", GD_BUILD_PGO_GENERATE);
+    json_bool("pgo_use", GD_BUILD_PGO_USE);
+    json_bool("fast_math", GD_FAST_MATH);
+    json_bool("address_sanitizer", GD_SANITIZER_ADDRESS);
+    json_bool("thread_sanitizer", GD_SANITIZER_THREAD);
+    json_bool("memory_sanitizer", GD_SANITIZER_MEMORY);
+    json_bool("undefined_sanitizer", GD_SANITIZER_UNDEFINED);
+    json_end_object();
+
+    json_end_object();
+}
+
+/* Runtime detection */
+
+static const char* cache_type_name(gd_cache_type_t type)
+{
+    switch (type)
+    {
+    case GD_CACHE_TYPE_DATA: return "data";
+    case GD_CACHE_TYPE_INSTRUCTION: return "instruction";
+    case GD_CACHE_TYPE_UNIFIED: return "unified";
+    }
+    return "unknown";
+}
+
+static const char* thp_mode_name(gd_thp_mode_t mode)
+{
+    switch (mode)
+    {
+    case GD_THP_MODE_NEVER: return "never";
+    case GD_THP_MODE_MADVISE: return "madvise";
+    case GD_THP_MODE_ALWAYS: return "always";
+    default: return "unknown";
+    }
+}
+
+static void print_runtime(void)
+{
+    static const char* const io_names[] = {
+        "io_uring", "splice", "copy_file_range", "sendfile", "msg_zerocopy", "memfd", "userfaultfd", "kqueue"
+    };
+    static const char* const virt_names[] = {
+        "host", "nested", "sandbox", "container", "wsl", "microvm", "pv_clock", "tsc_reliable", "dedicated_cpus"
+    };
+    static const char* const sync_names[] = {
+        "futex", "futex_waitv", "futex2", "umtx", "wait_on_address", "ulock", "os_sync_wait", "membarrier", "rseq", "rseq_libc", "getcpu"
+    };
+    const gd_cpu_model_t* model = gd_cpu_model();
+    const gd_cache_info_t* caches = gd_cache_info();
+    const gd_topology_t* topology = gd_topology();
+    const gd_page_info_t* pages = gd_page_info();
+    const gd_limits_t* limits = gd_limits();
+    const gd_virt_info_t* virt = gd_virt_info();
+    const gd_io_info_t* io = gd_io_info();
+    const gd_sync_info_t* sync = gd_sync_info();
+    gd_isa_check_t isa;
+    char report[256];
+    unsigned int i;
+
+    json_begin_object("runtime");
+
+    json_begin_object("cpu");
+    json_string("vendor", gd_cpu_vendor_name(model->vendor));
+    json_string("uarch", gd_uarch_name(model->uarch));
+    json_string("brand", model->brand);
+    json_uint("family", model->family);
+    json_uint("model", model->model);
+    json_uint("stepping", model->stepping);
+    if (model->midr)
+        json_uint("midr", model->midr);
+    json_features("features", gd_cpu_features());
+    gd_isa_check(&isa);
+    gd_isa_report(&isa, report, sizeof(report));
+    json_int("isa_level", isa.host_level);
+    json_int("build_isa_level", isa.level);
+    json_features("missing", isa.missing);
+    json_features("unused", isa.unused);
+    json_string("isa_report", report);
+    json_end_object();
+
+    json_begin_object("caches");
+    json_int("line_size", caches->line_size);
+    json_begin_array("levels");
+    for (i = 0; i < caches->count; i++)
+    {
+        json_begin_object(NULL);
+        json_int("level", caches->caches[i].level);
+        json_string("type", cache_type_name(caches->caches[i].type));
+        json_uint("size", caches->caches[i].size);
+        json_int("line_size", caches->caches[i].line_size);
+        json_uint("associativity", caches->caches[i].associativity);
+        json_int("shared_by", caches->caches[i].shared_by);
+        json_end_object();
+    }
+    json_end_array();
+    json_end_object();
+
+    json_begin_object("topology");
+    json_int("cpus", topology->cpu_count);
+    json_int("cores", topology->core_count);
+    json_int("packages", topology->package_count);
+    json_int("smt_width", topology->smt_width);
+    json_int("performance_cores", topology->performance_core_count);
+    json_int("efficiency_cores", topology->efficiency_core_count);
+    json_begin_array("nodes");
+    for (i = 0; i < topology->node_count; i++)
+    {
+        json_begin_object(NULL);
+        json_int("id", topology->nodes[i].id);
+        json_int("cpus", topology->nodes[i].cpu_count);
+        json_uint("memory", topology->nodes[i].memory);
+        json_end_object();
+    }
+    json_end_array();
+    json_end_object();
+
+    json_begin_object("pages");
+    json_uint("page_size", pages->page_size);
+    json_uint("allocation_granularity", pages->allocation_granularity);
+    json_string("thp_mode", thp_mode_name(pages->thp_mode));
+    json_uint("thp_size", pages->thp_size);
+    json_begin_array("huge_pages");
+    for (i = 0; i < pages->huge_page_count; i++)
+    {
+        json_begin_object(NULL);
+        json_uint("size", pages->huge_pages[i].size);
+        json_uint("total", pages->huge_pages[i].total);
+        json_uint("free", pages->huge_pages[i].free);
+        json_end_object();
+    }
+    json_end_array();
+    json_end_object();
+
+    json_begin_object("limits");
+    json_int("cpus", limits->cpu_count);
+    json_uint("cpu_quota", limits->cpu_quota);
+    json_uint("cpu_period", limits->cpu_period);
+    json_int("parallelism", limits->parallelism);
+    json_uint("memory_total", limits->memory_total);
+    json_uint("memory_max", limits->memory_max);
+    json_uint("memory_high", limits->memory_high);
+    json_uint("memory_budget", limits->memory_budget);
+    json_int("cgroup_version", limits->cgroup_version);
+    json_end_object();
+
+    json_begin_object("virtualization");
+    json_string("hypervisor", gd_hypervisor_name(virt->hypervisor));
+    json_string("vendor", virt->vendor);
+    json_string("product", virt->product);
+    json_string("clocksource", virt->clocksource);
+    json_begin_array("flags");
+    for (i = 0; i < sizeof(virt_names) / sizeof(virt_names[0]); i++)
+        if (virt->flags & (1u << i))
+            json_string(NULL, virt_names[i]);
+    json_end_array();
+    json_end_object();
+
+    json_begin_object("timer");
+    json_bool("cycle_counter", GD_HAS_CYCLE_COUNTER);
+    json_bool("invariant", gd_cycles_invariant());
+    json_uint("frequency", gd_cycles_frequency());
+    json_end_object();
+
+    json_string("allocator", gd_allocator_name(gd_allocator()));
+
+    json_begin_object("io");
+    json_begin_array("capabilities");
+    for (i = 0; i < sizeof(io_names) / sizeof(io_names[0]); i++)
+        if (io->capabilities & (1u << i))
+            json_string(NULL, io_names[i]);
+    json_end_array();
+    json_uint("io_uring_features", io->io_uring_features);
+    json_end_object();
+
+    json_begin_object("sync");
+    json_begin_array("capabilities");
+    for (i = 0; i < sizeof(sync_names) / sizeof(sync_names[0]); i++)
+        if (sync->capabilities & (1u << i))
+            json_string(NULL, sync_names[i]);
+    json_end_array();
+    json_uint("membarrier_commands", sync->membarrier_commands);
+    json_end_object();
+
+    json_end_object();
+}
+
+/* Benchmark helpers */
+
+#if GD_INTERNAL_GNUC
+    #define ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define ATOMIC_ADD(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_ACQ_REL)
+    #define ATOMIC_CAS(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#elif defined(GD_COMPILER_MSVC)
+    #define ATOMIC_LOAD(ptr) InterlockedCompareExchange((ptr), 0, 0)
+    #define ATOMIC_STORE(ptr, value) ((void)InterlockedExchange((ptr), (value)))
+    #define ATOMIC_ADD(ptr, value) InterlockedAdd((ptr), (value))
+    #define ATOMIC_CAS(ptr, expected, desired) (InterlockedCompareExchange((ptr), (desired), (expected)) == (expected))
+#else
+    #error "gd-info needs GCC, Clang or MSVC atomics"
+#endif
+
+/* A value alone on its cache line, so nothing else in the tool shares it */
+typedef struct padded
+{
+    char before[GD_DESTRUCTIVE_INTERFERENCE_SIZE];
+    volatile long value;
+    char after[GD_DESTRUCTIVE_INTERFERENCE_SIZE];
+} padded_t;
+
+typedef void (*thread_function_t)(void* argument);
+
+typedef struct thread
+{
+    thread_function_t function;
+    void* argument;
+#ifdef GD_OS_WINDOWS
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+} thread_t;
+
+#ifdef GD_OS_WINDOWS
+static DWORD WINAPI thread_entry(LPVOID thread)
+{
+    ((thread_t*)thread)->function(((thread_t*)thread)->argument);
+    return 0;
+}
+
+static int thread_start(thread_t* thread)
+{
+    thread->handle = CreateThread(NULL, 0, thread_entry, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+static void thread_join(thread_t* thread)
+{
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+}
+#else
+static void* thread_entry(void* thread)
+{
+    ((thread_t*)thread)->function(((thread_t*)thread)->argument);
+    return NULL;
+}
+
+static int thread_start(thread_t* thread)
+{
+    return pthread_create(&thread->handle, NULL, thread_entry, thread) == 0;
+}
+
+static void thread_join(thread_t* thread)
+{
+    pthread_join(thread->handle, NULL);
+}
+#endif
+
+/* Runs function(arguments[i]) on count threads, each pinned to a CPU, returns 0 if a thread could not be started */
+static int run_threads(unsigned int count, thread_function_t function, void* arguments, size_t argument_size)
+{
+    thread_t* threads = (thread_t*)calloc(count, sizeof(thread_t));
+    unsigned int i, started = 0;
+
+    if (!threads)
+        return 0;
+    for (i = 0; i < count; i++)
+    {
+        threads[i].function = function;
+        threads[i].argument = (char*)arguments + i * argument_size;
+        if (!thread_start(&threads[i]))
+            break;
+        started++;
+    }
+    for (i = 0; i < started; i++)
+        thread_join(&threads[i]);
+    free(threads);
+    return started == count;
+}
+
+static void barrier_wait(volatile long* barrier, long count)
+{
+    ATOMIC_ADD(barrier, 1);
+    while (ATOMIC_LOAD(barrier) < count)
+        ;
+}
+
+/* Pins the thread and waits for the others, returns 0 if any of them could not be pinned */
+static int pin_and_wait(unsigned int cpu, int pin, volatile long* barrier, volatile long* failed, long count)
+{
+    if (pin && !gd_thread_pin_cpu(cpu))
+        ATOMIC_ADD(failed, 1);
+    barrier_wait(barrier, count);
+    return ATOMIC_LOAD(failed) == 0;
+}
+
+/* The CPUs of the topology the process may run on, a cpuset or taskset can leave out some of them */
+static const gd_topology_cpu_t* allowed_cpus[GD_TOPOLOGY_MAX_CPUS];
+static unsigned int allowed_cpu_count = 0;
+
+static void find_allowed_cpus(void)
+{
+    const gd_topology_t* topology = gd_topology();
+#if defined(GD_OS_LINUX)
+    const unsigned int bits = sizeof(unsigned long) * 8;
+    unsigned long words[GD_TOPOLOGY_MAX_CPUS / (sizeof(unsigned long) * 8) + 1];
+    long size;
+#elif defined(GD_OS_WINDOWS)
+    DWORD_PTR process = 0, system = 0;
+#endif
+    unsigned int i, id;
+    int known = 0;
+
+#if defined(GD_OS_LINUX)
+    memset(words, 0, sizeof(words));
+    size = syscall(SYS_sched_getaffinity, 0, sizeof(words), words);
+    known = size > 0;
+#elif defined(GD_OS_WINDOWS)
+    known = GetProcessAffinityMask(GetCurrentProcess(), &process, &system) != 0;
+#endif
+
+    /* Where the affinity can not be read every CPU is tried, and pinning fails for the ones that are not allowed */
+    allowed_cpu_count = 0;
+    for (i = 0; i < topology->cpu_count; i++)
+    {
+        id = topology->cpus[i].id;
+#if defined(GD_OS_LINUX)
+        if (known && (id >= (unsigned int)size * 8 || !((words[id / bits] >> (id % bits)) & 1)))
+            continue;
+#elif defined(GD_OS_WINDOWS)
+        if (known && (id >= sizeof(process) * 8 || !((process >> id) & 1)))
+            continue;
+#else
+        (void)known;
+        (void)id;
+#endif
+        allowed_cpus[allowed_cpu_count++] = &topology->cpus[i];
+    }
+}
+
+/* The CPU for the index-th thread, round robin over the allowed ones */
+static unsigned int allowed_cpu(unsigned int index)
+{
+    return allowed_cpu_count ? allowed_cpus[index % allowed_cpu_count]->id : index;
+}
+
+static unsigned long long elapsed_ns(unsigned long long start)
+{
+    return gd_cycles_to_ns(gd_cycles() - start);
+}
+
+/* Aligns a malloc'ed buffer to a page, the original pointer is stored right before the result */
+static void* page_alloc(size_t size)
+{
+    size_t page = (size_t)gd_page_size();
+    char* raw = (char*)malloc(size + page + sizeof(void*));
+    char* aligned;
+
+    if (!raw)
+        return NULL;
+    aligned = (char*)(((size_t)raw + sizeof(void*) + page - 1) & ~(page - 1));
+    ((void**)aligned)[-1] = raw;
+    memset(aligned, 1, size);
+    return aligned;
+}
+
+static void page_free(void* buffer)
+{
+    if (buffer)
+        free(((void**)buffer)[-1]);
+}
+
+static unsigned long long random_next(unsigned long long* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static unsigned long long last_level_cache_size(void)
+{
+    const gd_cache_info_t* caches = gd_cache_info();
+    unsigned long long size = 0;
+    unsigned int i;
+
+    for (i = 0; i < caches->count; i++)
+        if (caches->caches[i].type != GD_CACHE_TYPE_INSTRUCTION && caches->caches[i].size > size)
+            size = caches->caches[i].size;
+    return size ? size : 8ull << 20;
+}
+
+/* Benchmark: load latency */
+
+/* Follows a random cycle through the lines of a buffer, so every load depends on the previous one */
+static double load_latency_ns(size_t size, size_t line)
+{
+    size_t count = size / line, i, j, swap;
+    size_t* order = (size_t*)malloc(count * sizeof(size_t));
+    char* buffer = (char*)page_alloc(size);
+    unsigned long long state = 0x9E3779B97F4A7C15ull, start, steps = 1u << 22, step;
+    void** p;
+    double result = 0;
+
+    if (order && buffer && count > 1)
+    {
+        for (i = 0; i < count; i++)
+            order[i] = i;
+        for (i = count - 1; i > 0; i--)
+        {
+            j = (size_t)(random_next(&state) % (i + 1));
+            swap = order[i];
+            order[i] = order[j];
+            order[j] = swap;
+        }
+        for (i = 0; i < count; i++)
+            *(void**)(buffer + order[i] * line) = buffer + order[(i + 1) % count] * line;
+
+        /* One pass to warm up the caches and the TLB */
+        p = (void**)(buffer + order[0] * line);
+        for (i = 0; i < count; i++)
+            p = (void**)*p;
+
+        start = gd_cycles();
+        for (step = 0; step < steps; step++)
+            p = (void**)*p;
+        result = (double)elapsed_ns(start) / (double)steps;
+
+        /* Keeps the chain from being optimized out */
+        if (p == NULL)
+            result = -1;
+    }
+    free(order);
+    page_free(buffer);
+    return result;
+}
+
+static void bench_latency(void)
+{
+    const gd_cache_info_t* caches = gd_cache_info();
+    size_t line = caches->line_size ? caches->line_size : GD_CACHE_LINE_SIZE;
+    unsigned long long memory_size = last_level_cache_size() * 4;
+    unsigned int i;
+
+    if (memory_size < (64ull << 20))
+        memory_size = 64ull << 20;
+
+    json_begin_array("load_latency_ns");
+    for (i = 0; i < caches->count; i++)
+    {
+        const gd_cache_t* cache = &caches->caches[i];
+        char name[8];
+
+        if (cache->type == GD_CACHE_TYPE_INSTRUCTION)
+            continue;
+        sprintf(name, "L%u", cache->level);
+        json_begin_object(NULL);
+        json_string("level", name);
+        json_uint("size", cache->size / 2);
+        json_double("ns", load_latency_ns((size_t)(cache->size / 2), line));
+        json_end_object();
+    }
+    json_begin_object(NULL);
+    json_string("level", "memory");
+    json_uint("size", memory_size);
+    json_double("ns", load_latency_ns((size_t)memory_size, line));
+    json_end_object();
+    json_end_array();
+}
+
+/* Benchmark: memory bandwidth */
+
+typedef struct bandwidth_task
+{
+    unsigned int cpu;
+    size_t size;
+    unsigned int passes;
+    volatile long* barrier;
+    volatile long* failed;
+    long thread_count;
+    unsigned long long start;
+    unsigned long long end;
+    unsigned long long sum;
+} bandwidth_task_t;
+
+static unsigned long long read_buffer(const unsigned long long* buffer, size_t count)
+{
+    unsigned long long a = 0, b = 0, c = 0, d = 0;
+    size_t i;
+
+    for (i = 0; i + 4 <= count; i += 4)
+    {
+        a += buffer[i];
+        b += buffer[i + 1];
+        c += buffer[i + 2];
+        d += buffer[i + 3];
+    }
+    return a + b + c + d;
+}
+
+static void bandwidth_thread(void* argument)
+{
+    bandwidth_task_t* task = (bandwidth_task_t*)argument;
+    unsigned long long* buffer;
+    unsigned int pass;
+
+    /* Pinning first makes the buffer local to the NUMA node of the CPU */
+    if (task->thread_count > 1 && !gd_thread_pin_cpu(task->cpu))
+        ATOMIC_ADD(task->failed, 1);
+    buffer = (unsigned long long*)page_alloc(task->size);
+    barrier_wait(task->barrier, task->thread_count);
+    if (ATOMIC_LOAD(task->failed))
+    {
+        page_free(buffer);
+        return;
+    }
+    task->start = gd_cycles();
+    if (buffer)
+        for (pass = 0; pass < task->passes; pass++)
+            task->sum += read_buffer(buffer, task->size / sizeof(unsigned long long));
+    task->end = gd_cycles();
+    if (!buffer)
+        task->size = 0;
+    page_free(buffer);
+}
+
+/* Returns the combined read bandwidth of threads each reading its own buffer, in GB/s, or -1 if they could not be pinned */
+static double read_bandwidth(unsigned int thread_count, size_t size)
+{
+    bandwidth_task_t* tasks = (bandwidth_task_t*)calloc(thread_count, sizeof(bandwidth_task_t));
+    volatile long barrier = 0, failed = 0;
+    unsigned long long first = 0, last = 0, bytes = 0;
+    unsigned int i;
+
+    if (!tasks)
+        return 0;
+    for (i = 0; i < thread_count; i++)
+    {
+        tasks[i].cpu = allowed_cpu(i);
+        tasks[i].size = size;
+        tasks[i].passes = 4;
+        tasks[i].barrier = &barrier;
+        tasks[i].failed = &failed;
+        tasks[i].thread_count = (long)thread_count;
+    }
+    if (!run_threads(thread_count, bandwidth_thread, tasks, sizeof(bandwidth_task_t)) || failed)
+    {
+        free(tasks);
+        return failed ? -1 : 0;
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        if (i == 0 || tasks[i].start < first)
+            first = tasks[i].start;
+        if (tasks[i].end > last)
+            last = tasks[i].end;
+        bytes += (unsigned long long)tasks[i].size * tasks[i].passes;
+    }
+    free(tasks);
+    return last > first ? (double)bytes / (double)gd_cycles_to_ns(last - first) : 0;
+}
+
+static void bench_bandwidth(void)
+{
+    unsigned int cpus = gd_parallelism();
+    unsigned long long size = last_level_cache_size() * 4, per_thread;
+
+    if (size < (64ull << 20))
+        size = 64ull << 20;
+    /* Together the threads still read well past the last level cache */
+    per_thread = size / cpus;
+    if (per_thread < (8ull << 20))
+        per_thread = 8ull << 20;
+
+    json_begin_object("read_bandwidth_gbps");
+    json_measurement("single_core", read_bandwidth(1, (size_t)size));
+    json_measurement("all_cores", read_bandwidth(cpus, (size_t)per_thread));
+    json_int("threads", cpus);
+    json_end_object();
+}
+
+/* Benchmark: core to core latency */
+
+#define PING_PONG_ROUNDS 100000
+
+typedef struct ping_pong_task
+{
+    unsigned int cpu;
+    int first;
+    volatile long* line;
+    volatile long* barrier;
+    volatile long* failed;
+    unsigned long long time;
+} ping_pong_task_t;
+
+static void ping_pong_thread(void* argument)
+{
+    ping_pong_task_t* task = (ping_pong_task_t*)argument;
+    unsigned long long start;
+    long round;
+
+    /* Two spinning threads on one CPU would hand over the line once per scheduler time slice */
+    if (!pin_and_wait(task->cpu, 1, task->barrier, task->failed, 2))
+        return;
+    start = gd_cycles();
+    for (round = 0; round < PING_PONG_ROUNDS; round++)
+    {
+        if (task->first)
+        {
+            ATOMIC_STORE(task->line, 2 * round + 1);
+            while (ATOMIC_LOAD(task->line) != 2 * round + 2)
+                ;
+        }
+        else
+        {
+            while (ATOMIC_LOAD(task->line) != 2 * round + 1)
+                ;
+            ATOMIC_STORE(task->line, 2 * round + 2);
+        }
+    }
+    task->time = elapsed_ns(start);
+}
+
+/* Returns the one way latency of handing a cache line between two CPUs in ns, or -1 if they could not be pinned */
+static double ping_pong_ns(unsigned int cpu_a, unsigned int cpu_b)
+{
+    static padded_t line;
+    volatile long barrier = 0, failed = 0;
+    ping_pong_task_t tasks[2];
+
+    line.value = 0;
+    memset(tasks, 0, sizeof(tasks));
+    tasks[0].cpu = cpu_a;
+    tasks[0].first = 1;
+    tasks[1].cpu = cpu_b;
+    tasks[0].line = tasks[1].line = &line.value;
+    tasks[0].barrier = tasks[1].barrier = &barrier;
+    tasks[0].failed = tasks[1].failed = &failed;
+    if (!run_threads(2, ping_pong_thread, tasks, sizeof(ping_pong_task_t)))
+        return 0;
+    if (failed)
+        return -1;
+    return (double)tasks[0].time / (2.0 * PING_PONG_ROUNDS);
+}
+
+static void bench_ping_pong_pair(const char* kind, const gd_topology_cpu_t* a, const gd_topology_cpu_t* b)
+{
+    json_begin_object(NULL);
+    json_string("kind", kind);
+    json_int("cpu_a", a->id);
+    json_int("cpu_b", b->id);
+    json_measurement("ns", ping_pong_ns(a->id, b->id));
+    json_end_object();
+}
+
+static void bench_ping_pong(void)
+{
+    const gd_topology_cpu_t *first, *sibling = NULL, *same_package = NULL, *other_package = NULL;
+    unsigned int i;
+
+    json_begin_array("core_to_core_latency");
+    if (allowed_cpu_count < 2)
+    {
+        json_end_array();
+        return;
+    }
+    first = allowed_cpus[0];
+    for (i = 1; i < allowed_cpu_count; i++)
+    {
+        const gd_topology_cpu_t* cpu = allowed_cpus[i];
+        if (cpu->package != first->package)
+        {
+            if (!other_package)
+                other_package = cpu;
+        }
+        else if (cpu->core == first->core)
+        {
+            if (!sibling)
+                sibling = cpu;
+        }
+        else if (!same_package)
+            same_package = cpu;
+    }
+
+    if (sibling)
+        bench_ping_pong_pair("smt_sibling", first, sibling);
+    if (same_package)
+        bench_ping_pong_pair("same_package", first, same_package);
+    if (other_package)
+        bench_ping_pong_pair("other_package", first, other_package);
+    json_end_array();
+}
+
+/* Benchmark: CAS throughput */
+
+#define CAS_OPERATIONS 2000000
+
+typedef struct cas_task
+{
+    unsigned int cpu;
+    volatile long* counter;
+    volatile long* barrier;
+    volatile long* failed;
+    long thread_count;
+    unsigned long long start;
+    unsigned long long end;
+} cas_task_t;
+
+static void cas_thread(void* argument)
+{
+    cas_task_t* task = (cas_task_t*)argument;
+    long done = 0, value;
+
+    if (!pin_and_wait(task->cpu, task->thread_count > 1, task->barrier, task->failed, task->thread_count))
+        return;
+    task->start = gd_cycles();
+    while (done < CAS_OPERATIONS)
+    {
+        value = *task->counter;
+        if (ATOMIC_CAS(task->counter, value, value + 1))
+            done++;
+    }
+    task->end = gd_cycles();
+}
+
+/* Returns the successful CAS operations per second (in millions) of threads incrementing one counter, or -1 if they could not be pinned */
+static double cas_mops(unsigned int thread_count)
+{
+    static padded_t counter;
+    cas_task_t* tasks = (cas_task_t*)calloc(thread_count, sizeof(cas_task_t));
+    volatile long barrier = 0, failed = 0;
+    unsigned long long first = 0, last = 0;
+    unsigned int i;
+
+    if (!tasks)
+        return 0;
+    for (i = 0; i < thread_count; i++)
+    {
+        tasks[i].cpu = allowed_cpu(i);
+        tasks[i].counter = &counter.value;
+        tasks[i].barrier = &barrier;
+        tasks[i].failed = &failed;
+        tasks[i].thread_count = (long)thread_count;
+    }
+    if (!run_threads(thread_count, cas_thread, tasks, sizeof(cas_task_t)) || failed)
+    {
+        free(tasks);
+        return failed ? -1 : 0;
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        if (i == 0 || tasks[i].start < first)
+            first = tasks[i].start;
+        if (tasks[i].end > last)
+            last = tasks[i].end;
+    }
+    free(tasks);
+    return last > first ? (double)thread_count * CAS_OPERATIONS * 1000.0 / (double)gd_cycles_to_ns(last - first) : 0;
+}
+
+static void bench_cas(void)
+{
+    unsigned int cpus = gd_parallelism();
+
+    json_begin_object("cas_mops");
+    json_measurement("single_thread", cas_mops(1));
+    json_measurement("all_cores_contended", cas_mops(cpus));
+    json_int("threads", cpus);
+    json_end_object();
+}
+
+int main(int argc, char** argv)
+{
+    int bench = 0, snapshot = 0, i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--bench") == 0)
+            bench = 1;
+        else if (strcmp(argv[i], "--save-snapshot") == 0)
+            snapshot = 1;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--bench] [--save-snapshot]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (snapshot && !gd_snapshot_save(NULL))
+    {
+        fprintf(stderr, "Could not write the snapshot to %s\n", GD_SNAPSHOT_PATH);
+        return 1;
+    }
+
+    json_begin_object(NULL);
+    print_compile_time();
+    print_runtime();
+    if (bench)
+    {
+        json_begin_object("bench");
+        find_allowed_cpus();
+        bench_latency();
+        bench_bandwidth();
+        bench_ping_pong();
+        bench_cas();
+        json_end_object();
+    }
+    json_end_object();
+    putchar('\n');
+    return 0;
+}
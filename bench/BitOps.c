@@ -0,0 +1,89 @@
+/* This file is public domain */
+
+/*
+ * Compares the GenericDetect bit manipulation helpers with plain portable
+ * implementations. Build it with and without e.g. -march=native to see the
+ * difference the instructions make.
+ *
+ * Build: cc -O2 -I.. BitOps.c -o BitOps
+ */
+
+#define GD_IMPLEMENTATION
+#include "GenericDetect.h"
+
+#include <stdio.h>
+
+#define ITERATIONS 100000000u
+
+static int popcount_portable(unsigned long long x)
+{
+    int count = 0;
+    for (; x; x &= x - 1)
+        count++;
+    return count;
+}
+
+static int clz_portable(unsigned long long x)
+{
+    int count = 0;
+    if (x == 0)
+        return 64;
+    for (; !(x & 0x8000000000000000ull); x <<= 1)
+        count++;
+    return count;
+}
+
+static int ctz_portable(unsigned long long x)
+{
+    int count = 0;
+    if (x == 0)
+        return 64;
+    for (; !(x & 1); x >>= 1)
+        count++;
+    return count;
+}
+
+static void report(const char* name, gd_u64_t cycles, unsigned long long result)
+{
+    printf("%-20s %8.3f ns/op (result %llu)\n", name, (double)gd_cycles_to_ns(cycles) / ITERATIONS, result);
+}
+
+/* xorshift, so the compiler can not precompute the inputs */
+#define NEXT(x) ((x) ^= (x) << 13, (x) ^= (x) >> 7, (x) ^= (x) << 17)
+
+#define RUN(name, expression)                                 \
+    do                                                        \
+    {                                                         \
+        unsigned long long x = 0x9E3779B97F4A7C15ull;         \
+        unsigned long long result = 0;                        \
+        gd_u64_t start = gd_cycles_serialized();              \
+        for (i = 0; i < ITERATIONS; i++)                      \
+        {                                                     \
+            NEXT(x);                                          \
+            result += (unsigned long long)(expression);       \
+        }                                                     \
+        report(name, gd_cycles_serialized() - start, result); \
+    } while (0)
+
+int main(void)
+{
+    unsigned int i;
+
+    printf("GD_HAS_FAST_POPCOUNT %d\n", GD_HAS_FAST_POPCOUNT);
+    printf("GD_HAS_FAST_CLZ      %d\n", GD_HAS_FAST_CLZ);
+    printf("GD_HAS_FAST_CTZ      %d\n", GD_HAS_FAST_CTZ);
+    printf("GD_HAS_FAST_PDEP     %d\n", GD_HAS_FAST_PDEP);
+
+    /* Calibrate the counter before the first measurement */
+    (void)gd_cycles_frequency();
+
+    RUN("popcount portable", popcount_portable(x));
+    RUN("gd_popcount64", gd_popcount64(x));
+    RUN("clz portable", clz_portable(x >> (x & 63)));
+    RUN("gd_clz64", gd_clz64(x >> (x & 63)));
+    RUN("ctz portable", ctz_portable(x << (x & 63)));
+    RUN("gd_ctz64", gd_ctz64(x << (x & 63)));
+    RUN("gd_pext64", gd_pext64(x, 0x00FF00FF00FF00FFull));
+
+    return 0;
+}
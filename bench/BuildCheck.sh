@@ -0,0 +1,45 @@
+#!/bin/sh
+# This file is public domain
+
+#
+# Compiles GenericDetect.h, with and without GD_IMPLEMENTATION, in the
+# configurations the library supports and fails on any warning. Each argument
+# adds a set of flags to check, e.g. -m32.
+#
+# Usage: ./BuildCheck.sh [flags]...
+#
+
+CC=${CC:-cc}
+CXX=${CXX:-c++}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+FAILED=0
+
+# check <compiler> <flags>
+check()
+{
+    for implementation in "" "-DGD_IMPLEMENTATION"; do
+        if $1 $2 $implementation -Wall -Wextra -Werror -I"$ROOT" -c "$ROOT/GenericDetect.h" -o "$TMP/test.o" 2> "$TMP/log"; then
+            printf '%-4s %-64s ok\n' "$1" "$2 $implementation"
+        else
+            FAILED=1
+            printf '%-4s %-64s FAILED\n' "$1" "$2 $implementation"
+            head -n 5 "$TMP/log"
+        fi
+    done
+}
+
+check "$CC" "-x c -std=c89 -pedantic"
+check "$CC" "-x c -std=c99 -pedantic"
+check "$CC" "-x c -std=gnu11"
+check "$CC" "-x c -std=c99 -DGD_NO_EXTERNAL_INCLUDES=1"
+check "$CXX" "-x c++ -std=c++98 -pedantic"
+check "$CXX" "-x c++"
+check "$CXX" "-x c++ -DGD_NO_EXTERNAL_INCLUDES=1"
+
+for flags in "$@"; do
+    check "$CC" "-x c $flags"
+done
+
+exit $FAILED
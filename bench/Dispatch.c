@@ -0,0 +1,82 @@
+/* This file is public domain */
+
+/*
+ * Measures the cost of calling a GD_DISPATCH function compared to a direct
+ * call and a call through a plain function pointer. Add -DGD_DISPATCH_IFUNC=1
+ * to measure the GNU indirect function instead.
+ *
+ * Build: cc -O2 -I.. Dispatch.c -o Dispatch
+ */
+
+#define GD_IMPLEMENTATION
+#include "GenericDetect.h"
+
+#include <stdio.h>
+
+#define ITERATIONS 200000000u
+
+GD_NOINLINE static unsigned int add_generic(unsigned int a, unsigned int b)
+{
+    return a + b;
+}
+
+GD_NOINLINE static unsigned int add_fast(unsigned int a, unsigned int b)
+{
+    return b + a;
+}
+
+GD_DISPATCH_DECLARE(unsigned int, add_dispatched, (unsigned int a, unsigned int b));
+
+static GD_DISPATCH_TYPE(add_dispatched) add_resolve(void)
+{
+#if GD_HAS_IFUNC && GD_DISPATCH_IFUNC && (defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64))
+    /* The dynamic loader runs it while relocating, so it can not call gd_cpu_has */
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return add_fast;
+#elif defined(GD_ARCH_X86) || defined(GD_ARCH_X86_64)
+    if (gd_cpu_has(GD_CPU_FEATURE_AVX2))
+        return add_fast;
+#endif
+    return add_generic;
+}
+
+GD_DISPATCH(unsigned int, add_dispatched, (unsigned int a, unsigned int b), (a, b), add_resolve);
+
+/* Volatile, so the compiler can not turn the indirect call into a direct one */
+static unsigned int (*volatile add_pointer)(unsigned int, unsigned int) = add_generic;
+
+static void report(const char* name, gd_u64_t cycles, unsigned int result)
+{
+    printf("%-16s %8.3f ns/call (result %u)\n", name, (double)gd_cycles_to_ns(cycles) / ITERATIONS, result);
+}
+
+int main(void)
+{
+    unsigned int i, result;
+    unsigned int (*pointer)(unsigned int, unsigned int) = add_pointer;
+    gd_u64_t start;
+
+    printf("Dispatch mechanism: %s\n", GD_HAS_IFUNC && GD_DISPATCH_IFUNC ? "ifunc" : "function pointer");
+
+    /* Resolve and calibrate the counter before timing */
+    result = add_dispatched(0, 0);
+    (void)gd_cycles_frequency();
+
+    start = gd_cycles_serialized();
+    for (i = 0; i < ITERATIONS; i++)
+        result = add_generic(result, i);
+    report("direct", gd_cycles_serialized() - start, result);
+
+    start = gd_cycles_serialized();
+    for (i = 0; i < ITERATIONS; i++)
+        result = pointer(result, i);
+    report("function pointer", gd_cycles_serialized() - start, result);
+
+    start = gd_cycles_serialized();
+    for (i = 0; i < ITERATIONS; i++)
+        result = add_dispatched(result, i);
+    report("GD_DISPATCH", gd_cycles_serialized() - start, result);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#!/bin/sh
+# This file is public domain
+
+#
+# Checks that GD_ISA_CHECK_AT_STARTUP notices builds the CPU can not run. A
+# small program is built for every x86-64 level and then run, builds above the
+# CPU have to abort with the report and the others have to run. Each argument is
+# a set of flags for extensions the CPU lacks, which have to abort as well, e.g.
+# -mavx10.1, or -D__AVX10_1__ with compilers that do not know it yet. Exits with
+# 1 if any result is wrong.
+#
+# Usage: ./IsaCheck.sh [flags]...
+#
+
+CC=${CC:-cc}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+FAILED=0
+
+cat > "$TMP/test.c" << 'EOF'
+#define GD_ISA_CHECK_AT_STARTUP 1
+#define GD_IMPLEMENTATION
+#include "GenericDetect.h"
+
+#include <stdio.h>
+
+int main(void)
+{
+    printf("%u\n", gd_isa_level(gd_cpu_features()));
+    return 0;
+}
+EOF
+
+# check <flags> <expected: run or abort>
+check()
+{
+    if ! $CC -O2 $1 -I"$ROOT" "$TMP/test.c" -o "$TMP/test" 2> /dev/null; then
+        printf '%-24s skipped, the compiler does not support it\n' "$1"
+        return
+    fi
+    "$TMP/test" > /dev/null 2> "$TMP/report"
+    status=$?
+    case $status in
+        0) result=run ;;
+        134) result=abort ;;
+        *) result="crashed with status $status before the check" ;;
+    esac
+    if [ "$2" != "$result" ]; then
+        FAILED=1
+        printf '%-24s FAILED, expected %s but it %s\n' "$1" "$2" "$result"
+    else
+        printf '%-24s %s %s\n' "$1" "$result" "$(head -n 1 "$TMP/report")"
+    fi
+}
+
+case $(uname -m) in
+    x86_64|amd64)
+        HOST=$($CC -O2 -march=x86-64 -I"$ROOT" "$TMP/test.c" -o "$TMP/host" && "$TMP/host") || exit 1
+        echo "The CPU supports x86-64-v$HOST"
+        check "-march=x86-64" run
+        for level in 2 3 4; do
+            if [ "$level" -le "$HOST" ]; then
+                check "-march=x86-64-v$level" run
+            else
+                check "-march=x86-64-v$level" abort
+            fi
+        done
+        ;;
+esac
+
+for flags in "$@"; do
+    check "$flags" abort
+done
+
+exit $FAILED
@@ -0,0 +1,57 @@
+#!/bin/sh
+# This file is public domain
+
+#
+# Measures the preprocessing time and the number of defined macros of
+# GenericDetect.h and each of its sub-headers, with and without
+# GD_NO_EXTERNAL_INCLUDES. That option alone still lets LibC.h include the
+# headers it detects the libc with (e.g. <features.h>), so it changes nothing
+# on its own. Only together with GD_NO_LIBC_DETECTION does it leave out every
+# external header. The "(empty)" row is the cost of running the compiler on
+# an empty file, which every other row includes.
+#
+# Usage: ./Preprocess.sh [compiler] [iterations]
+#
+
+CC=${1:-cc}
+ITERATIONS=${2:-50}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+now()
+{
+    time=$(date +%s%N)
+    case $time in
+        *N) perl -MTime::HiRes=time -e 'printf "%.0f\n", time * 1e9' ;;
+        *) echo "$time" ;;
+    esac
+}
+
+# run <name> <flags> <source>
+run()
+{
+    printf '%s\n' "$3" > "$TMP/test.c"
+    macros=$($CC $2 -I"$ROOT" -dM -E "$TMP/test.c" | wc -l)
+    start=$(now)
+    i=0
+    while [ $i -lt "$ITERATIONS" ]; do
+        $CC $2 -I"$ROOT" -E "$TMP/test.c" -o /dev/null || exit 1
+        i=$((i + 1))
+    done
+    end=$(now)
+    awk -v name="$1" -v flags="$2" -v ns=$((end - start)) -v n="$ITERATIONS" -v macros="$macros" \
+        'BEGIN { printf "%-36s %-54s %8.3f ms %6d macros\n", name, flags, ns / n / 1e6, macros }'
+}
+
+echo "$CC, $ITERATIONS iterations"
+run "(empty)" "" ""
+for flags in "" "-DGD_NO_EXTERNAL_INCLUDES=1" "-DGD_NO_EXTERNAL_INCLUDES=1 -DGD_NO_LIBC_DETECTION=1"; do
+    run "GenericDetect.h" "$flags" '#include "GenericDetect.h"'
+    for header in "$ROOT"/GenericDetect/*.h; do
+        name=GenericDetect/$(basename "$header")
+        [ "$name" = "GenericDetect/Implementation.h" ] && continue
+        run "$name" "$flags" "#include \"$name\""
+    done
+done
+run "GenericDetect.h" "-DGD_IMPLEMENTATION" '#include "GenericDetect.h"'
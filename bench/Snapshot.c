@@ -0,0 +1,89 @@
+/* This file is public domain */
+
+/*
+ * Measures how long a new process takes to get the runtime detection results,
+ * once by probing and once from a snapshot written by gd_snapshot_save.
+ *
+ * Build: cc -O2 -I.. Snapshot.c -o Snapshot
+ */
+
+#define GD_IMPLEMENTATION
+#include "GenericDetect.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define RUNS 50
+#define PATH "/tmp/gd-bench.snapshot"
+
+/* What a worker process would query at startup */
+static void query(void)
+{
+    volatile unsigned long long sink;
+    sink = gd_cpu_features();
+    sink = gd_cycles_frequency();
+    sink = gd_cpu_model()->uarch;
+    sink = gd_cache_size(2);
+    sink = gd_topology()->core_count;
+    sink = gd_page_size();
+    sink = gd_parallelism();
+    sink = gd_virt_info()->hypervisor;
+    (void)sink;
+}
+
+/* 0 - probe, 1 - load the snapshot, 2 - save it */
+static int child(int mode)
+{
+    if (mode == 2)
+        return gd_snapshot_save(PATH);
+    if (mode == 1 && !gd_snapshot_load(PATH))
+        return 0;
+    query();
+    return 1;
+}
+
+/*
+ * Everything runs in fresh children, a child of a process that probed already would inherit its caches.
+ * Returns the cycles all runs took, or 0 if a child failed.
+ */
+static gd_u64_t run(int mode, int runs)
+{
+    gd_u64_t start = gd_cycles_serialized();
+    int i, status;
+    pid_t pid;
+
+    for (i = 0; i < runs; i++)
+    {
+        pid = fork();
+        if (pid == 0)
+            _exit(child(mode) ? 0 : 1);
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            return 0;
+    }
+    return gd_cycles_serialized() - start;
+}
+
+int main(void)
+{
+    gd_u64_t probed, loaded;
+
+    if (!run(2, 1))
+    {
+        printf("Could not write %s\n", PATH);
+        return 1;
+    }
+    probed = run(0, RUNS);
+    loaded = run(1, RUNS);
+    unlink(PATH);
+
+    if (!probed || !loaded)
+    {
+        printf("A child process failed, the snapshot was not loaded\n");
+        return 1;
+    }
+    /* Only now, calibrating the counter earlier would hand the frequency to the children */
+    printf("probing    %8.1f us/process\n", (double)gd_cycles_to_ns(probed) / 1e3 / RUNS);
+    printf("snapshot   %8.1f us/process\n", (double)gd_cycles_to_ns(loaded) / 1e3 / RUNS);
+    return 0;
+}